@@ -0,0 +1,215 @@
+#include "bench.h"
+#include "map.h"
+#include "player.h"
+#include "input.h"
+#include "simulation.h"
+#include "profiler.h"
+#include "stage_loader.h"
+#include <stdint.h>
+
+#define BENCH_MAX_SCRIPT_STEPS 1024
+
+// 스크립트 한 줄: ticks 동안 같은 입력 유지
+typedef struct {
+    long ticks;
+    PlayerInput input;
+} ScriptStep;
+
+// 무작위 입력 상태 (플레이어별로 방향을 몇 틱씩 유지)
+typedef struct {
+    int direction;    // -1 왼쪽, 0 정지, 1 오른쪽
+    int hold_ticks;   // 방향을 바꾸기까지 남은 틱
+} RandomWalker;
+
+static uint32_t rng_state = 1;
+
+// xorshift32 (플랫폼과 무관하게 같은 시드면 같은 입력열)
+static uint32_t bench_random(void) {
+    uint32_t x = rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng_state = x;
+    return x;
+}
+
+static void random_keys(RandomWalker* walker, KeyState* keys) {
+    if (walker->hold_ticks <= 0) {
+        walker->direction = (int)(bench_random() % 3) - 1;
+        walker->hold_ticks = 1 + (int)(bench_random() % 20);
+    }
+    walker->hold_ticks--;
+
+    memset(keys, 0, sizeof(KeyState));
+    keys->left = walker->direction < 0;
+    keys->right = walker->direction > 0;
+    keys->jump = (bench_random() % 16) == 0;
+    keys->up = keys->jump;
+}
+
+// 키 문자열 파싱 (L/R/J 조합, "-"는 입력 없음)
+static bool parse_keys(const char* text, KeyState* keys) {
+    memset(keys, 0, sizeof(KeyState));
+    if (strcmp(text, "-") == 0) return true;
+
+    for (const char* p = text; *p; p++) {
+        switch (*p) {
+            case 'L': case 'l': keys->left = true; break;
+            case 'R': case 'r': keys->right = true; break;
+            case 'J': case 'j': keys->jump = true; keys->up = true; break;
+            default: return false;
+        }
+    }
+    return true;
+}
+
+// 입력 스크립트 로드
+// 형식: 한 줄에 "틱수 Fireboy키 Watergirl키" (예: "20 RJ L"), '#'으로 시작하면 주석
+static int load_script(const char* filename, ScriptStep* steps, int max_steps) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        printf("입력 스크립트를 열 수 없습니다: %s\n", filename);
+        return -1;
+    }
+
+    char line[128];
+    int line_no = 0;
+    int count = 0;
+    while (fgets(line, sizeof(line), file) && count < max_steps) {
+        line_no++;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\0') continue;
+
+        long ticks;
+        char fire_keys[16];
+        char water_keys[16];
+        if (sscanf(line, "%ld %15s %15s", &ticks, fire_keys, water_keys) != 3 || ticks <= 0 ||
+            !parse_keys(fire_keys, &steps[count].input.fireboy) ||
+            !parse_keys(water_keys, &steps[count].input.watergirl)) {
+            printf("입력 스크립트 %d번째 줄 형식 오류: %s", line_no, line);
+            fclose(file);
+            return -1;
+        }
+        steps[count].ticks = ticks;
+        count++;
+    }
+    fclose(file);
+
+    if (count == 0) {
+        printf("입력 스크립트가 비어있습니다: %s\n", filename);
+        return -1;
+    }
+    return count;
+}
+
+// 최종 상태 해시 (FNV-1a): 빌드 간 시뮬레이션 결과가 같은지 확인용
+static uint64_t hash_int(uint64_t hash, int value) {
+    for (int i = 0; i < 4; i++) {
+        hash ^= (uint64_t)((value >> (i * 8)) & 0xFF);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static uint64_t state_hash(const Map* map, const Player* fireboy, const Player* watergirl) {
+    uint64_t hash = 14695981039346656037ULL;
+    hash = hash_int(hash, fireboy->x);
+    hash = hash_int(hash, fireboy->y);
+    hash = hash_int(hash, watergirl->x);
+    hash = hash_int(hash, watergirl->y);
+    for (int i = 0; i < map->box_count; i++) {
+        hash = hash_int(hash, map->boxes[i].x);
+        hash = hash_int(hash, map->boxes[i].y);
+    }
+    for (int i = 0; i < map->switch_count; i++) {
+        hash = hash_int(hash, map->switches[i].activated);
+    }
+    return hash;
+}
+
+static void respawn(Map* map, Player* fireboy, Player* watergirl) {
+    map_reset(map);
+    player_init(fireboy, PLAYER_FIREBOY, map->fireboy_start_x, map->fireboy_start_y);
+    player_init(watergirl, PLAYER_WATERGIRL, map->watergirl_start_x, map->watergirl_start_y);
+}
+
+// 헤드리스 벤치마크 실행
+int bench_run(const BenchOptions* options) {
+    if (!options || options->ticks <= 0 || options->tick_rate <= 0) return 1;
+    float delta_time = 1.0f / (float)options->tick_rate;
+
+    static ScriptStep script[BENCH_MAX_SCRIPT_STEPS];
+    int script_steps = 0;
+    if (options->script_file) {
+        script_steps = load_script(options->script_file, script, BENCH_MAX_SCRIPT_STEPS);
+        if (script_steps < 0) return 1;
+    }
+    rng_state = options->seed ? options->seed : 1;
+
+    char stage_file[256];
+    stage_get_filename(options->stage_id, stage_file, sizeof(stage_file));
+    Map* map = map_load_from_file(stage_file);
+    if (!map) return 1;
+
+    Player fireboy, watergirl;
+    player_init(&fireboy, PLAYER_FIREBOY, map->fireboy_start_x, map->fireboy_start_y);
+    player_init(&watergirl, PLAYER_WATERGIRL, map->watergirl_start_x, map->watergirl_start_y);
+
+    RandomWalker walkers[2] = {{0, 0}, {0, 0}};
+    int step = 0;
+    long step_ticks_left = script_steps > 0 ? script[0].ticks : 0;
+    long deaths = 0;
+    long clears = 0;
+
+    profiler_init();
+    uint64_t start_ns = profiler_now_ns();
+
+    for (long tick = 0; tick < options->ticks; tick++) {
+        // 입력 생성 (스크립트는 끝나면 처음부터 반복)
+        PlayerInput input;
+        if (script_steps > 0) {
+            if (step_ticks_left <= 0) {
+                step = (step + 1) % script_steps;
+                step_ticks_left = script[step].ticks;
+            }
+            input = script[step].input;
+            step_ticks_left--;
+        } else {
+            random_keys(&walkers[0], &input.fireboy);
+            random_keys(&walkers[1], &input.watergirl);
+        }
+
+        simulation_step(map, &fireboy, &watergirl, &input, delta_time);
+
+        // 사망/클리어 시 스테이지 처음부터 다시
+        if (fireboy.state == PLAYER_STATE_DEAD || watergirl.state == PLAYER_STATE_DEAD) {
+            deaths++;
+            respawn(map, &fireboy, &watergirl);
+        } else if (fireboy.x == map->exit_x && fireboy.y == map->exit_y &&
+                   watergirl.x == map->exit_x && watergirl.y == map->exit_y) {
+            clears++;
+            respawn(map, &fireboy, &watergirl);
+        }
+    }
+
+    uint64_t elapsed_ns = profiler_now_ns() - start_ns;
+    double elapsed_sec = (double)elapsed_ns / 1e9;
+
+    printf("stage        %d\n", options->stage_id);
+    if (options->script_file) {
+        printf("input        script %s (%d steps)\n", options->script_file, script_steps);
+    } else {
+        printf("input        random seed %u\n", options->seed);
+    }
+    printf("ticks        %ld @ %d Hz\n", options->ticks, options->tick_rate);
+    printf("elapsed_s    %.6f\n", elapsed_sec);
+    printf("ticks_per_s  %.0f\n", elapsed_sec > 0.0 ? (double)options->ticks / elapsed_sec : 0.0);
+    printf("ns_per_tick  %.1f\n", (double)elapsed_ns / (double)options->ticks);
+    printf("deaths       %ld\n", deaths);
+    printf("clears       %ld\n", clears);
+    printf("state_hash   %016llx\n", (unsigned long long)state_hash(map, &fireboy, &watergirl));
+    printf("\n");
+    profiler_print_summary(stdout);
+
+    map_destroy(map);
+    return 0;
+}
@@ -0,0 +1,20 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "common.h"
+
+// 헤드리스 시뮬레이션 벤치마크 설정
+typedef struct {
+    int stage_id;             // 불러올 스테이지
+    long ticks;               // 실행할 틱 수
+    unsigned int seed;        // 무작위 입력 시드
+    const char* script_file;  // 입력 스크립트 (NULL이면 무작위 입력)
+    int tick_rate;            // 시뮬레이션 주기 (Hz)
+} BenchOptions;
+
+#define BENCH_DEFAULT_TICKS 100000
+
+// 터미널 없이 잠자지 않고 시뮬레이션만 반복 실행 후 결과 출력 (종료 코드 반환)
+int bench_run(const BenchOptions* options);
+
+#endif // BENCH_H
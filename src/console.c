@@ -1,4 +1,9 @@
+// fopencookie (glibc) 사용
+#define _GNU_SOURCE
 #include "console.h"
+#include "metrics.h"
+#include <errno.h>
+#include <poll.h>
 
 // 콘솔 초기화
 void console_init(void) {
@@ -77,3 +82,50 @@ void console_set_attribute(ConsoleAttribute attr) {
     fflush(stdout);
 }
 
+// stdout에 쓴 바이트를 그대로 터미널로 보내면서 메트릭에 집계
+static long counting_write_impl(const char* buf, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        ssize_t n = write(STDOUT_FILENO, buf + written, size - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // 입력 초기화로 터미널이 논블로킹이 된 경우 쓸 수 있을 때까지 대기
+                struct pollfd pfd = { STDOUT_FILENO, POLLOUT, 0 };
+                poll(&pfd, 1, 100);
+                continue;
+            }
+            break;
+        }
+        written += (size_t)n;
+    }
+    metrics_add(METRIC_RENDER_BYTES, written);
+    return written > 0 ? (long)written : -1;
+}
+
+#ifdef __APPLE__
+static int counting_write(void* cookie, const char* buf, int size) {
+    (void)cookie;
+    return (int)counting_write_impl(buf, (size_t)size);
+}
+#else
+static ssize_t counting_write(void* cookie, const char* buf, size_t size) {
+    (void)cookie;
+    return (ssize_t)counting_write_impl(buf, size);
+}
+#endif
+
+// 터미널 출력 바이트 수를 집계하도록 stdout 교체
+bool console_count_output(void) {
+    fflush(stdout);
+#ifdef __APPLE__
+    FILE* counted = funopen(NULL, NULL, counting_write, NULL, NULL);
+#else
+    cookie_io_functions_t io = { NULL, counting_write, NULL, NULL };
+    FILE* counted = fopencookie(NULL, "w", io);
+#endif
+    if (!counted) return false;
+    setvbuf(counted, NULL, _IOLBF, BUFSIZ); // 터미널과 같은 줄 단위 버퍼링
+    stdout = counted;
+    return true;
+}
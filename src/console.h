@@ -35,6 +35,7 @@ void console_reset_color(void);
 void console_set_color_fg(ConsoleColor color);
 void console_set_color_bg(ConsoleColor color);
 void console_set_attribute(ConsoleAttribute attr);
+bool console_count_output(void); // 출력 바이트 수를 메트릭에 집계
 
 #endif // CONSOLE_H
 
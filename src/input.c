@@ -1,4 +1,12 @@
 #include "input.h"
+#include "metrics.h"
+#include "vt_parser.h"
+#include "timer.h"
+#include <sys/uio.h>
+#include <poll.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 #ifdef PLATFORM_UNIX
     static struct termios old_termios;
@@ -8,47 +16,341 @@
 static PlayerInput current_input = {0};
 static PlayerInput key_states = {0}; // 키 상태 추적 (키를 누르고 있는 동안 true 유지)
 static bool quit_requested = false;
+static atomic_bool stdin_closed = false; // 터미널이 닫힘 (입력 스레드가 설정, 종료 요청으로 취급)
 static int last_stage_key = -1; // 마지막에 눌린 숫자키 (1-3)
+static bool profiler_key_pressed = false; // 프로파일러 오버레이 토글 키 (P)
 
-// 키 입력 타임스탬프 (마지막 키 입력 시간)
-static struct timespec last_key_time[6] = {0}; // fireboy.left, fireboy.right, fireboy.jump, watergirl.left, watergirl.right, watergirl.jump
+// stdin 링 버퍼 (입력 스레드가 한 번의 readv로 모아 읽고 메모리에서 해석)
+#define INPUT_RING_SIZE 4096 // 2의 거듭제곱
+#define INPUT_RING_MASK (INPUT_RING_SIZE - 1)
+static unsigned char input_ring[INPUT_RING_SIZE];
+static size_t ring_head = 0; // 다음에 꺼낼 위치 (계속 증가, 인덱스는 마스크로 계산)
+static size_t ring_tail = 0; // 다음에 채울 위치
+
+// 키 입력 타임스탬프 (마지막 키 입력 시각, timer_now_ns 기준)
+static uint64_t last_key_ns[6] = {0}; // fireboy.left, fireboy.right, fireboy.jump, watergirl.left, watergirl.right, watergirl.jump
 #define KEY_TIMEOUT_MS 100 // 100ms 타임아웃
 
-// 현재 시간 가져오기
-static void get_current_time(struct timespec* ts) {
-    // Unix/macOS/Linux
-    clock_gettime(CLOCK_MONOTONIC, ts);
-}
+// 입력 스레드 → 게임 루프 이벤트 큐 (단일 생산자/단일 소비자, 잠금 없음)
+typedef struct {
+    VtEvent key;
+    uint64_t time_ns; // 바이트를 읽은 시각 (timer_now_ns 기준)
+} InputEvent;
+
+#define INPUT_EVENT_QUEUE_SIZE 256 // 2의 거듭제곱
+#define INPUT_EVENT_QUEUE_MASK (INPUT_EVENT_QUEUE_SIZE - 1)
+static InputEvent event_queue[INPUT_EVENT_QUEUE_SIZE];
+static _Atomic size_t event_head = 0; // 소비자(게임 루프)만 씀
+static _Atomic size_t event_tail = 0; // 생산자(입력 스레드)만 씀
+
+// 입력 스레드
+static pthread_t input_thread;
+static bool input_thread_running = false;
+static int wake_pipe[2] = { -1, -1 }; // 이벤트를 넣으면 한 바이트 써서 input_wait를 깨움
+static int stop_pipe[2] = { -1, -1 }; // 스레드 종료 요청
+
+// 키보드 보고 방식
+typedef enum {
+    KEYBOARD_LEGACY,           // 키 반복 바이트만 옴 (떼기 이벤트 없음, 시간 제한으로 추정)
+    KEYBOARD_MODIFY_OTHER,     // xterm modifyOtherKeys (수식키 조합 구분, 떼기 이벤트 없음)
+    KEYBOARD_KITTY             // kitty 프로토콜 (누름/반복/떼기 이벤트)
+} KeyboardProtocol;
+
+static KeyboardProtocol keyboard_protocol = KEYBOARD_LEGACY;
+static bool keyboard_probe_pending = false; // 질의를 보내고 응답을 기다리는 중
+static bool kitty_supported = false;        // 한 번 확인되면 다음 초기화부터는 질의 생략
+
+// kitty 플래그: 1(모호한 키 구분) | 2(이벤트 종류 보고) | 8(모든 키를 이스케이프 코드로)
+#define KITTY_KEYBOARD_FLAGS "11"
+
+// 이스케이프 시퀀스 해석기 (입력 스레드 소유, 잘려서 들어온 시퀀스도 다음 읽기에서 이어서 해석)
+static VtParser vt_parser;
+static bool vt_parser_ready = false;
 
-// 시간 차이 계산 (밀리초)
-static long time_diff_ms(const struct timespec* t1, const struct timespec* t2) {
-    long sec_diff = t1->tv_sec - t2->tv_sec;
-    long nsec_diff = t1->tv_nsec - t2->tv_nsec;
-    return sec_diff * 1000 + nsec_diff / 1000000;
+// 키가 눌렸을 때의 동작
+typedef enum {
+    ACTION_NONE,
+    ACTION_FIREBOY_UP,
+    ACTION_FIREBOY_DOWN,
+    ACTION_FIREBOY_LEFT,
+    ACTION_FIREBOY_RIGHT,
+    ACTION_WATERGIRL_UP,
+    ACTION_WATERGIRL_DOWN,
+    ACTION_WATERGIRL_LEFT,
+    ACTION_WATERGIRL_RIGHT,
+    ACTION_ENTER,
+    ACTION_QUIT,
+    ACTION_STAGE_1,
+    ACTION_STAGE_2,
+    ACTION_STAGE_3,
+    ACTION_PROFILER
+} InputAction;
+
+// 키 바인딩 표 (VT_KEY_CHAR이면 ch로 구분, 바인딩 추가는 여기에 한 줄)
+typedef struct {
+    VtKey key;
+    unsigned char ch;
+    InputAction action;
+} KeyBinding;
+
+static const KeyBinding key_bindings[] = {
+    { VT_KEY_UP,     0,         ACTION_FIREBOY_UP },
+    { VT_KEY_DOWN,   0,         ACTION_FIREBOY_DOWN },
+    { VT_KEY_LEFT,   0,         ACTION_FIREBOY_LEFT },
+    { VT_KEY_RIGHT,  0,         ACTION_FIREBOY_RIGHT },
+    { VT_KEY_CHAR,   'w',       ACTION_WATERGIRL_UP },
+    { VT_KEY_CHAR,   'W',       ACTION_WATERGIRL_UP },
+    { VT_KEY_CHAR,   's',       ACTION_WATERGIRL_DOWN },
+    { VT_KEY_CHAR,   'S',       ACTION_WATERGIRL_DOWN },
+    { VT_KEY_CHAR,   'a',       ACTION_WATERGIRL_LEFT },
+    { VT_KEY_CHAR,   'A',       ACTION_WATERGIRL_LEFT },
+    { VT_KEY_CHAR,   'd',       ACTION_WATERGIRL_RIGHT },
+    { VT_KEY_CHAR,   'D',       ACTION_WATERGIRL_RIGHT },
+    { VT_KEY_CHAR,   KEY_ENTER, ACTION_ENTER },
+    { VT_KEY_CHAR,   13,        ACTION_ENTER },
+    { VT_KEY_ESCAPE, 0,         ACTION_QUIT },
+    { VT_KEY_CHAR,   '1',       ACTION_STAGE_1 },
+    { VT_KEY_CHAR,   '2',       ACTION_STAGE_2 },
+    { VT_KEY_CHAR,   '3',       ACTION_STAGE_3 },
+    { VT_KEY_CHAR,   'p',       ACTION_PROFILER },
+    { VT_KEY_CHAR,   'P',       ACTION_PROFILER }
+};
+
+// 바인딩 표에서 만든 조회 배열
+static uint8_t char_actions[256];
+static uint8_t key_actions[VT_KEY_COUNT];
+
+static void input_build_bindings(void) {
+    memset(char_actions, ACTION_NONE, sizeof(char_actions));
+    memset(key_actions, ACTION_NONE, sizeof(key_actions));
+    for (size_t i = 0; i < sizeof(key_bindings) / sizeof(key_bindings[0]); i++) {
+        const KeyBinding* b = &key_bindings[i];
+        if (b->key == VT_KEY_CHAR) {
+            char_actions[b->ch] = (uint8_t)b->action;
+        } else {
+            key_actions[b->key] = (uint8_t)b->action;
+        }
+    }
 }
 
-// 논블로킹 문자 입력 처리 (Unix/macOS/Linux)
-int input_getch_non_blocking(void) {
-    fd_set readfds;
-    struct timeval timeout;
+// 링 버퍼의 빈 공간을 readv 한 번으로 채움 (stdin은 O_NONBLOCK이라 데이터가 없으면 바로 반환)
+// 반환값: EOF나 EIO 등으로 더 읽을 수 없으면 false
+static bool input_fill_ring(void) {
+    size_t used = ring_tail - ring_head;
+    if (used == INPUT_RING_SIZE) return true;
+    
+    size_t tail_idx = ring_tail & INPUT_RING_MASK;
+    size_t free_space = INPUT_RING_SIZE - used;
+    size_t first = INPUT_RING_SIZE - tail_idx; // 끝까지 연속된 공간
+    if (first > free_space) first = free_space;
     
-    FD_ZERO(&readfds);
-    FD_SET(STDIN_FILENO, &readfds);
+    // 끝에서 감기는 경우 앞부분까지 두 조각으로 한 번에 읽음
+    struct iovec iov[2];
+    iov[0].iov_base = &input_ring[tail_idx];
+    iov[0].iov_len = first;
+    iov[1].iov_base = &input_ring[0];
+    iov[1].iov_len = free_space - first;
     
-    timeout.tv_sec = 0;
-    timeout.tv_usec = 0;
+    ssize_t n = readv(STDIN_FILENO, iov, iov[1].iov_len > 0 ? 2 : 1);
+    if (n > 0) {
+        ring_tail += (size_t)n;
+        return true;
+    }
+    return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+}
+
+// 링 버퍼에서 한 바이트 꺼내기 (비어 있으면 -1)
+static int input_ring_pop(void) {
+    if (ring_head == ring_tail) return -1;
+    return input_ring[ring_head++ & INPUT_RING_MASK];
+}
+
+// 이벤트 큐에 넣기 (입력 스레드 전용, 가득 차면 버림)
+static bool event_queue_push(const VtEvent* key, uint64_t time_ns) {
+    size_t tail = atomic_load_explicit(&event_tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&event_head, memory_order_acquire);
+    if (tail - head == INPUT_EVENT_QUEUE_SIZE) return false;
     
-    if (select(STDIN_FILENO + 1, &readfds, NULL, NULL, &timeout) > 0) {
-        char ch;
-        if (read(STDIN_FILENO, &ch, 1) == 1) {
-            return (unsigned char)ch;
+    event_queue[tail & INPUT_EVENT_QUEUE_MASK].key = *key;
+    event_queue[tail & INPUT_EVENT_QUEUE_MASK].time_ns = time_ns;
+    atomic_store_explicit(&event_tail, tail + 1, memory_order_release);
+    return true;
+}
+
+// 맨 앞 이벤트 보기 (게임 루프 전용, 비어 있으면 NULL)
+static const InputEvent* event_queue_peek(void) {
+    size_t head = atomic_load_explicit(&event_head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&event_tail, memory_order_acquire);
+    if (head == tail) return NULL;
+    return &event_queue[head & INPUT_EVENT_QUEUE_MASK];
+}
+
+static void event_queue_pop(void) {
+    size_t head = atomic_load_explicit(&event_head, memory_order_relaxed);
+    atomic_store_explicit(&event_head, head + 1, memory_order_release);
+}
+
+static bool event_queue_is_empty(void) {
+    return atomic_load_explicit(&event_head, memory_order_relaxed) ==
+           atomic_load_explicit(&event_tail, memory_order_acquire);
+}
+
+// 입력 스레드: stdin을 기다렸다가 읽은 바이트를 해석해 시각과 함께 큐에 넣음
+static void* input_thread_main(void* arg) {
+    (void)arg;
+    struct pollfd fds[2] = {
+        { STDIN_FILENO, POLLIN, 0 },
+        { stop_pipe[0], POLLIN, 0 }
+    };
+    
+    while (true) {
+        // 시퀀스 도중이면 단독 ESC 판정 시각에 맞춰 깨어남
+        int timeout_ms = -1;
+        if (vt_parser_is_pending(&vt_parser)) {
+            uint64_t waited_ns = timer_now_ns() - vt_parser.pending_since_ns;
+            timeout_ms = waited_ns >= VT_ESC_TIMEOUT_NS ? 0 : (int)((VT_ESC_TIMEOUT_NS - waited_ns) / 1000000ULL) + 1;
+        }
+        
+        if (poll(fds, 2, timeout_ms) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents) break;
+        
+        uint64_t now_ns = timer_now_ns();
+        bool pushed = false;
+        VtEvent event;
+        if (fds[0].revents) {
+            // 터미널이 닫히면(HUP/EOF/EIO) poll이 계속 바로 반환하므로 stdin은 그만 기다리고 종료 요청
+            if ((fds[0].revents & (POLLERR | POLLNVAL)) || !input_fill_ring()) {
+                fds[0].fd = -1;
+                atomic_store(&stdin_closed, true);
+                pushed = true;
+            }
+            int ch;
+            while ((ch = input_ring_pop()) != -1) {
+                if (vt_parser_feed(&vt_parser, (unsigned char)ch, now_ns, &event)) {
+                    pushed |= event_queue_push(&event, now_ns);
+                }
+            }
         }
+        
+        // 뒤따르는 바이트 없이 시간이 지난 ESC는 단독 ESC 키로 확정
+        if (vt_parser_poll_timeout(&vt_parser, now_ns, &event)) {
+            pushed |= event_queue_push(&event, now_ns);
+        }
+        
+        if (pushed) {
+            char wake = 1;
+            ssize_t written = write(wake_pipe[1], &wake, 1); // 파이프가 차 있으면 이미 깨울 예정
+            (void)written;
+        }
+    }
+    return NULL;
+}
+
+// 파이프를 논블로킹으로 만들기
+static void input_set_nonblocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+static void input_thread_start(void) {
+    if (input_thread_running) return;
+    if (wake_pipe[0] < 0) {
+        if (pipe(wake_pipe) < 0 || pipe(stop_pipe) < 0) return;
+        input_set_nonblocking(wake_pipe[0]);
+        input_set_nonblocking(wake_pipe[1]);
+        input_set_nonblocking(stop_pipe[0]);
+    }
+    
+    // 이전 실행에서 남은 잘린 시퀀스와 읽지 않은 바이트는 버림
+    ring_head = ring_tail = 0;
+    vt_parser_init(&vt_parser);
+    input_thread_running = pthread_create(&input_thread, NULL, input_thread_main, NULL) == 0;
+}
+
+static void input_thread_stop(void) {
+    if (!input_thread_running) return;
+    char stop = 1;
+    ssize_t written = write(stop_pipe[1], &stop, 1);
+    (void)written;
+    pthread_join(input_thread, NULL);
+    input_thread_running = false;
+    
+    char drain[16];
+    while (read(stop_pipe[0], drain, sizeof(drain)) > 0) {}
+}
+
+// 논블로킹 문자 입력 처리 (해석된 이벤트 중 문자와 ESC만 반환)
+int input_getch_non_blocking(void) {
+    const InputEvent* event;
+    while ((event = event_queue_peek()) != NULL) {
+        VtEvent key = event->key;
+        event_queue_pop();
+        if (key.type == VT_EVENT_RELEASE) continue;
+        if (key.key == VT_KEY_CHAR) return key.ch;
+        if (key.key == VT_KEY_ESCAPE) return KEY_ESC;
     }
     return -1;
 }
 
+// 아직 처리하지 않은 입력 버리기 (터미널 입력 큐 포함)
+void input_flush(void) {
+    atomic_store_explicit(&event_head, atomic_load_explicit(&event_tail, memory_order_acquire),
+                          memory_order_release);
+    if (!input_thread_running) {
+        // 스레드가 멈춰 있을 때만 생산자 쪽 상태를 건드림
+        ring_head = ring_tail = 0;
+        vt_parser_init(&vt_parser);
+    }
+    tcflush(STDIN_FILENO, TCIFLUSH);
+}
+
+// 터미널에 제어 시퀀스 전송 (화면 출력 버퍼와 섞이지 않도록 바로 비움)
+static void input_send_sequence(const char* sequence) {
+    fputs(sequence, stdout);
+    fflush(stdout);
+}
+
+// 키보드 보고 방식 전환
+static void input_enable_kitty(void) {
+    input_send_sequence("\033[>" KITTY_KEYBOARD_FLAGS "u");
+    keyboard_protocol = KEYBOARD_KITTY;
+    kitty_supported = true;
+}
+
+static void input_enable_modify_other(void) {
+    input_send_sequence("\033[>4;2m");
+    keyboard_protocol = KEYBOARD_MODIFY_OTHER;
+}
+
+static void input_restore_keyboard(void) {
+    if (keyboard_protocol == KEYBOARD_KITTY) {
+        input_send_sequence("\033[<u");
+    } else if (keyboard_protocol == KEYBOARD_MODIFY_OTHER) {
+        input_send_sequence("\033[>4m");
+    }
+    keyboard_protocol = KEYBOARD_LEGACY;
+    keyboard_probe_pending = false;
+}
+
+// 터미널 응답 처리: kitty 플래그 응답이 오면 kitty, 장치 속성 응답만 오면 modifyOtherKeys
+static void input_handle_report(const VtEvent* event) {
+    if (!keyboard_probe_pending) return;
+    keyboard_probe_pending = false;
+    if (event->key == VT_KEY_REPORT_KEYBOARD_FLAGS) {
+        input_enable_kitty();
+    } else {
+        input_enable_modify_other();
+    }
+}
+
 // 입력 시스템 초기화
 void input_init(void) {
+    if (!vt_parser_ready) {
+        input_build_bindings();
+        vt_parser_ready = true;
+    }
 #ifdef PLATFORM_UNIX
     if (!input_initialized) {
         struct termios new_termios;
@@ -62,6 +364,17 @@ void input_init(void) {
         tcsetattr(STDIN_FILENO, TCSANOW, &new_termios);
         fcntl(STDIN_FILENO, F_SETFL, O_NONBLOCK);
         input_initialized = true;
+        
+        // 키보드 프로토콜 질의 (응답은 input_update에서 비동기로 처리)
+        // 장치 속성 질의는 모든 터미널이 답하므로 kitty 응답이 없다는 판정 기준으로 사용
+        if (kitty_supported) {
+            input_enable_kitty();
+        } else {
+            input_send_sequence("\033[?u\033[c");
+            keyboard_probe_pending = true;
+        }
+        
+        input_thread_start();
     }
 #endif
 }
@@ -70,15 +383,113 @@ void input_init(void) {
 void input_cleanup(void) {
 #ifdef PLATFORM_UNIX
     if (input_initialized) {
+        input_thread_stop(); // 이름 입력 등 stdin을 직접 읽는 코드와 겹치지 않도록
+        input_restore_keyboard();
+        memset(&key_states, 0, sizeof(key_states));
         tcsetattr(STDIN_FILENO, TCSANOW, &old_termios);
         input_initialized = false;
     }
 #endif
 }
 
-// 입력 업데이트
-void input_update(void) {
-    // 점프 키는 매 프레임 초기화 (한 번만 점프하도록)
+// 해석된 키 이벤트 하나를 키 상태에 반영
+static void input_apply_event(const VtEvent* event, uint64_t time_ns) {
+    if (event->key == VT_KEY_REPORT_KEYBOARD_FLAGS || event->key == VT_KEY_REPORT_DEVICE_ATTRS) {
+        input_handle_report(event);
+        return;
+    }
+    
+    InputAction action = event->key == VT_KEY_CHAR
+        ? (InputAction)char_actions[event->ch]
+        : (InputAction)key_actions[event->key];
+    if (action == ACTION_NONE) return;
+    metrics_add(METRIC_INPUT_EVENTS, 1);
+    
+    // 떼기 이벤트 (kitty 프로토콜): 누르고 있는 동안 유지되는 이동 키만 해제
+    if (event->type == VT_EVENT_RELEASE) {
+        switch (action) {
+            case ACTION_FIREBOY_LEFT:    key_states.fireboy.left = false; break;
+            case ACTION_FIREBOY_RIGHT:   key_states.fireboy.right = false; break;
+            case ACTION_WATERGIRL_LEFT:  key_states.watergirl.left = false; break;
+            case ACTION_WATERGIRL_RIGHT: key_states.watergirl.right = false; break;
+            default: break;
+        }
+        return;
+    }
+    
+    switch (action) {
+        case ACTION_FIREBOY_UP:
+            key_states.fireboy.up = true;
+            current_input.fireboy.up = true;
+            key_states.fireboy.jump = true;
+            current_input.fireboy.jump = true;
+            last_key_ns[2] = time_ns;
+            break;
+        case ACTION_FIREBOY_DOWN:
+            key_states.fireboy.down = true;
+            current_input.fireboy.down = true;
+            break;
+        case ACTION_FIREBOY_LEFT:
+            key_states.fireboy.left = true;
+            last_key_ns[0] = time_ns;
+            break;
+        case ACTION_FIREBOY_RIGHT:
+            key_states.fireboy.right = true;
+            last_key_ns[1] = time_ns;
+            break;
+        case ACTION_WATERGIRL_UP:
+            key_states.watergirl.up = true;
+            current_input.watergirl.up = true;
+            key_states.watergirl.jump = true;
+            current_input.watergirl.jump = true;
+            last_key_ns[5] = time_ns;
+            break;
+        case ACTION_WATERGIRL_DOWN:
+            key_states.watergirl.down = true;
+            current_input.watergirl.down = true;
+            break;
+        case ACTION_WATERGIRL_LEFT:
+            key_states.watergirl.left = true;
+            last_key_ns[3] = time_ns;
+            break;
+        case ACTION_WATERGIRL_RIGHT:
+            key_states.watergirl.right = true;
+            last_key_ns[4] = time_ns;
+            break;
+        case ACTION_ENTER:
+            current_input.fireboy.enter = true;
+            current_input.watergirl.enter = true;
+            break;
+        case ACTION_QUIT:
+            current_input.fireboy.escape = true;
+            quit_requested = true;
+            break;
+        case ACTION_STAGE_1:
+        case ACTION_STAGE_2:
+        case ACTION_STAGE_3:
+            // 숫자키 저장 (스테이지 전환용)
+            last_stage_key = 1 + (int)(action - ACTION_STAGE_1);
+            break;
+        case ACTION_PROFILER:
+            // 프로파일러 오버레이 토글 (디버그용)
+            profiler_key_pressed = true;
+            break;
+        case ACTION_NONE:
+        default:
+            break;
+    }
+}
+
+// 키 떼기 추정: 마지막 입력 후 100ms가 지나면 떼어진 것으로 봄
+static void input_expire_key(bool* held, uint64_t last_ns, uint64_t now_ns) {
+    if (*held && now_ns > last_ns && now_ns - last_ns > (uint64_t)KEY_TIMEOUT_MS * 1000000ULL) {
+        *held = false;
+    }
+}
+
+// deadline_ns 이전에 들어온 입력만 반영 (이후 입력은 큐에 남겨 다음 호출에서 처리)
+void input_update_until(uint64_t deadline_ns) {
+    // 점프 키는 매 호출 초기화 (한 번만 점프하도록)
     current_input.fireboy.jump = false;
     current_input.watergirl.jump = false;
     current_input.fireboy.enter = false;
@@ -87,128 +498,24 @@ void input_update(void) {
     current_input.fireboy.down = false;
     current_input.watergirl.up = false;
     current_input.watergirl.down = false;
-    current_input.fireboy.enter = false;
     
-    // 현재 시간 가져오기
-    struct timespec current_time;
-    get_current_time(&current_time);
-    
-    // Unix/macOS/Linux: 비동기 키 입력 처리 (모든 입력 버퍼 읽기)
-    int ch;
-    while ((ch = input_getch_non_blocking()) != -1) {
-        // ESC 시퀀스 처리 (화살표 키)
-        if (ch == 27) {
-            int ch2 = input_getch_non_blocking();
-            if (ch2 == -1) {
-                // ESC 키만 눌림
-                current_input.fireboy.escape = true;
-                quit_requested = true;
-            } else if (ch2 == '[') {
-                int ch3 = input_getch_non_blocking();
-                if (ch3 != -1) {
-                    // 화살표 키 처리
-                    switch (ch3) {
-                        case 'A': // 위 화살표
-                            key_states.fireboy.up = true;
-                            current_input.fireboy.up = true;
-                            key_states.fireboy.jump = true;
-                            current_input.fireboy.jump = true;
-                            get_current_time(&last_key_time[2]);
-                            break;
-                        case 'B': // 아래 화살표
-                            key_states.fireboy.down = true;
-                            current_input.fireboy.down = true;
-                            break;
-                        case 'C': // 오른쪽 화살표
-                            key_states.fireboy.right = true;
-                            get_current_time(&last_key_time[1]);
-                            break;
-                        case 'D': // 왼쪽 화살표
-                            key_states.fireboy.left = true;
-                            get_current_time(&last_key_time[0]);
-                            break;
-                        default:
-                            break;
-                    }
-                }
-            }
-        } else {
-            switch (ch) {
-                case 'w':
-                case 'W':
-                    key_states.watergirl.up = true;
-                    current_input.watergirl.up = true;
-                    key_states.watergirl.jump = true;
-                    current_input.watergirl.jump = true;
-                    get_current_time(&last_key_time[5]);
-                    break;
-                case 's':
-                case 'S':
-                    key_states.watergirl.down = true;
-                    current_input.watergirl.down = true;
-                    break;
-                case 'a':
-                case 'A':
-                    key_states.watergirl.left = true;
-                    get_current_time(&last_key_time[3]);
-                    break;
-                case 'd':
-                case 'D':
-                    key_states.watergirl.right = true;
-                    get_current_time(&last_key_time[4]);
-                    break;
-                case KEY_ENTER:
-                case 13:
-                    current_input.fireboy.enter = true;
-                    current_input.watergirl.enter = true;
-                    break;
-                case '1':
-                case '2':
-                case '3':
-                    // 숫자키 저장 (스테이지 전환용)
-                    last_stage_key = ch - '0';
-                    break;
-            }
-        }
-    }
-    
-    // 타임아웃 체크: 마지막 입력 시간이 100ms 이상 지나면 false로 설정
-    // fireboy.left (인덱스 0)
-    if (key_states.fireboy.left) {
-        long diff = time_diff_ms(&current_time, &last_key_time[0]);
-        if (diff > KEY_TIMEOUT_MS) {
-            key_states.fireboy.left = false;
-        }
-    }
-    
-    // fireboy.right (인덱스 1)
-    if (key_states.fireboy.right) {
-        long diff = time_diff_ms(&current_time, &last_key_time[1]);
-        if (diff > KEY_TIMEOUT_MS) {
-            key_states.fireboy.right = false;
-        }
+    const InputEvent* event;
+    while ((event = event_queue_peek()) != NULL && event->time_ns <= deadline_ns) {
+        VtEvent key = event->key;
+        uint64_t time_ns = event->time_ns;
+        event_queue_pop();
+        input_apply_event(&key, time_ns);
     }
     
-    // fireboy.jump (인덱스 2) - 점프는 이미 위에서 처리됨
-    
-    // watergirl.left (인덱스 3)
-    if (key_states.watergirl.left) {
-        long diff = time_diff_ms(&current_time, &last_key_time[3]);
-        if (diff > KEY_TIMEOUT_MS) {
-            key_states.watergirl.left = false;
-        }
-    }
-    
-    // watergirl.right (인덱스 4)
-    if (key_states.watergirl.right) {
-        long diff = time_diff_ms(&current_time, &last_key_time[4]);
-        if (diff > KEY_TIMEOUT_MS) {
-            key_states.watergirl.right = false;
-        }
+    // 타임아웃 체크 (kitty 프로토콜이면 떼기 이벤트로 실제 상태를 알 수 있으므로 생략)
+    // fireboy.jump (인덱스 2), watergirl.jump (인덱스 5)는 이미 위에서 처리됨
+    if (keyboard_protocol != KEYBOARD_KITTY) {
+        input_expire_key(&key_states.fireboy.left, last_key_ns[0], deadline_ns);
+        input_expire_key(&key_states.fireboy.right, last_key_ns[1], deadline_ns);
+        input_expire_key(&key_states.watergirl.left, last_key_ns[3], deadline_ns);
+        input_expire_key(&key_states.watergirl.right, last_key_ns[4], deadline_ns);
     }
     
-    // watergirl.jump (인덱스 5) - 점프는 이미 위에서 처리됨
-    
     // 키 상태를 current_input에 복사 (점프는 제외, 이미 위에서 처리됨)
     current_input.fireboy.left = key_states.fireboy.left;
     current_input.fireboy.right = key_states.fireboy.right;
@@ -216,6 +523,11 @@ void input_update(void) {
     current_input.watergirl.right = key_states.watergirl.right;
 }
 
+// 입력 업데이트 (지금까지 들어온 입력 모두 반영)
+void input_update(void) {
+    input_update_until(timer_now_ns());
+}
+
 // 플레이어 입력 가져오기
 PlayerInput input_get_player_input(void) {
     return current_input;
@@ -228,7 +540,40 @@ int input_get_stage_key(void) {
     return key;
 }
 
+// 프로파일러 토글 키가 눌렸는지 반환 및 리셋
+bool input_get_profiler_key(void) {
+    bool pressed = profiler_key_pressed;
+    profiler_key_pressed = false; // 읽은 후 리셋
+    return pressed;
+}
+
+// 눌린 키가 하나도 없는지 확인 (유휴 프레임 판정용)
+bool input_is_idle(void) {
+    const KeyState* keys[2] = { &current_input.fireboy, &current_input.watergirl };
+    for (int i = 0; i < 2; i++) {
+        if (keys[i]->up || keys[i]->down || keys[i]->left || keys[i]->right ||
+            keys[i]->jump || keys[i]->escape || keys[i]->enter) {
+            return false;
+        }
+    }
+    return last_stage_key == -1 && !profiler_key_pressed && event_queue_is_empty();
+}
+
+// 입력이 들어올 때까지 대기 (timeout_ms < 0 이면 무한 대기)
+bool input_wait(int timeout_ms) {
+    if (!event_queue_is_empty()) return true; // 아직 처리하지 않은 이벤트가 남아 있음
+    if (wake_pipe[0] < 0) return false;
+    
+    struct pollfd pfd = { wake_pipe[0], POLLIN, 0 };
+    bool woken = poll(&pfd, 1, timeout_ms) > 0;
+    
+    // 깨우기 바이트는 버림 (이벤트 자체는 큐에 있음)
+    char drain[64];
+    while (read(wake_pipe[0], drain, sizeof(drain)) > 0) {}
+    return woken || !event_queue_is_empty();
+}
+
 // 종료 요청 확인
 bool input_is_quit_requested(void) {
-    return quit_requested;
+    return quit_requested || atomic_load(&stdin_closed);
 }
@@ -2,6 +2,7 @@
 #define INPUT_H
 
 #include "common.h"
+#include <stdint.h>
 
 // 키 입력 상태
 typedef struct {
@@ -24,10 +25,15 @@ typedef struct {
 void input_init(void);
 void input_cleanup(void);
 void input_update(void);
+void input_update_until(uint64_t deadline_ns); // deadline_ns(timer_now_ns 기준) 이전에 들어온 입력만 반영
 PlayerInput input_get_player_input(void);
 bool input_is_quit_requested(void);
 int input_getch_non_blocking(void); // 논블로킹 문자 입력
+void input_flush(void); // 아직 해석하지 않은 입력 버리기
 int input_get_stage_key(void); // 마지막에 눌린 스테이지 키 반환 (1-3, 없으면 -1)
+bool input_get_profiler_key(void); // 프로파일러 오버레이 토글 키(P)가 눌렸는지 반환
+bool input_is_idle(void); // 눌린 키가 하나도 없는지 확인
+bool input_wait(int timeout_ms); // 입력이 들어올 때까지 대기 (timeout_ms < 0 이면 무한 대기)
 
 // 키 코드 정의 (Unix/macOS/Linux)
 #define KEY_ESC 27
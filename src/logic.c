@@ -0,0 +1,147 @@
+#include "logic.h"
+
+// 게이트 이름 표 (파일의 키워드)
+static const struct {
+    const char* keyword;
+    LogicOp op;
+    bool has_param;
+} logic_keywords[] = {
+    { "AND",     LOGIC_AND,     false },
+    { "OR",      LOGIC_OR,      false },
+    { "XOR",     LOGIC_XOR,     false },
+    { "NOT",     LOGIC_NOT,     false },
+    { "LATCH",   LOGIC_LATCH,   true  },
+    { "COUNTER", LOGIC_COUNTER, true  }
+};
+
+// 게이트 정의 줄 파싱
+bool logic_parse_gate(const char* line, LogicGateDef* def) {
+    if (!line || !def) return false;
+
+    char buffer[256];
+    strncpy(buffer, line, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+
+    char* save = NULL;
+    char* token = strtok_r(buffer, " \t\r", &save);
+    if (!token) return false;
+
+    int k = 0;
+    int keyword_count = (int)(sizeof(logic_keywords) / sizeof(logic_keywords[0]));
+    while (k < keyword_count && strcmp(token, logic_keywords[k].keyword) != 0) k++;
+    if (k == keyword_count) return false;
+
+    memset(def, 0, sizeof(*def));
+    def->op = logic_keywords[k].op;
+
+    // 출력 이름
+    token = strtok_r(NULL, " \t\r", &save);
+    if (!token) return false;
+    strncpy(def->name, token, sizeof(def->name) - 1);
+
+    // LATCH 유지 틱 수 / COUNTER 목표 횟수
+    if (logic_keywords[k].has_param) {
+        token = strtok_r(NULL, " \t\r", &save);
+        if (!token) return false;
+        def->param = atoi(token);
+        if (def->param < 1) def->param = 1;
+    }
+
+    // 입력 이름들
+    while ((token = strtok_r(NULL, " \t\r", &save)) != NULL && def->input_count < MAX_LOGIC_INPUTS) {
+        strncpy(def->input_names[def->input_count], token, sizeof(def->input_names[0]) - 1);
+        def->input_count++;
+    }
+    return def->input_count > 0;
+}
+
+// 위상 정렬 (아직 배치하지 않은 게이트의 출력에 의존하지 않는 게이트부터 차례로 배치)
+int logic_compile(LogicNetwork* net, const LogicGateDef* defs, int def_count) {
+    if (!net) return 0;
+    memset(net, 0, sizeof(*net));
+    if (!defs || def_count <= 0) return 0;
+    if (def_count > MAX_LOGIC_GATES) def_count = MAX_LOGIC_GATES;
+
+    uint64_t pending_outputs = 0;
+    bool placed[MAX_LOGIC_GATES] = { false };
+    for (int i = 0; i < def_count; i++) {
+        // 입력이 없는 게이트는 AND/NOT이 항상 켜지므로 컴파일하지 않음 (출력은 꺼진 신호로 취급)
+        if (defs[i].inputs == 0) {
+            placed[i] = true;
+            continue;
+        }
+        pending_outputs |= 1ULL << defs[i].output;
+    }
+
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (int i = 0; i < def_count; i++) {
+            if (placed[i] || (defs[i].inputs & pending_outputs)) continue;
+
+            int n = net->gate_count++;
+            net->gates[n].op = (uint8_t)defs[i].op;
+            net->gates[n].output = (uint8_t)defs[i].output;
+            net->gates[n].param = defs[i].param;
+            net->gates[n].inputs = defs[i].inputs;
+            placed[i] = true;
+            pending_outputs &= ~(1ULL << defs[i].output);
+            progress = true;
+        }
+    }
+    return net->gate_count;
+}
+
+// 네트워크 평가 (평면마다 입력 마스크와 AND 한 번 + 게이트 종류별 비교)
+void logic_evaluate(LogicNetwork* net, uint64_t bits[LOGIC_PLANE_COUNT]) {
+    if (!net) return;
+
+    bool timers_active = false;
+    for (int k = 0; k < net->gate_count; k++) {
+        uint64_t output_bit = 1ULL << net->gates[k].output;
+        for (int p = 0; p < LOGIC_PLANE_COUNT; p++) {
+            uint64_t in = bits[p] & net->gates[k].inputs;
+            bool out = false;
+            switch ((LogicOp)net->gates[k].op) {
+                case LOGIC_AND:
+                    out = in == net->gates[k].inputs;
+                    break;
+                case LOGIC_OR:
+                    out = in != 0;
+                    break;
+                case LOGIC_XOR:
+                    out = (__builtin_popcountll(in) & 1) != 0;
+                    break;
+                case LOGIC_NOT:
+                    out = in == 0;
+                    break;
+                case LOGIC_LATCH:
+                    // 입력이 켜져 있는 동안 타이머를 채우고, 꺼지면 매 틱 하나씩 줄임
+                    if (in) {
+                        net->gates[k].state[p] = net->gates[k].param;
+                        out = true;
+                    } else if (net->gates[k].state[p] > 0) {
+                        net->gates[k].state[p]--;
+                        out = true;
+                        timers_active = true; // 입력 변화가 없어도 다음 틱에 다시 평가
+                    }
+                    break;
+                case LOGIC_COUNTER:
+                    // 꺼짐 -> 켜짐 변화만 셈
+                    if (in && !net->gates[k].last_input[p] &&
+                        net->gates[k].state[p] < net->gates[k].param) {
+                        net->gates[k].state[p]++;
+                    }
+                    net->gates[k].last_input[p] = in != 0;
+                    out = net->gates[k].state[p] >= net->gates[k].param;
+                    break;
+            }
+            if (out) {
+                bits[p] |= output_bit;
+            } else {
+                bits[p] &= ~output_bit;
+            }
+        }
+    }
+    net->timers_active = timers_active;
+}
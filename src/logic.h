@@ -0,0 +1,62 @@
+#ifndef LOGIC_H
+#define LOGIC_H
+
+#include "common.h"
+#include <stdint.h>
+
+// 스위치 그룹 위의 논리 게이트 네트워크
+// 신호는 비트 하나 (스위치 그룹 + 게이트 출력, 최대 64개)이고 평면 두 개를 함께 계산함
+//   - 평면 0: 눌린 스위치가 있는지 (토글 발판 제어)
+//   - 평면 1: 상자가 올라간 스위치가 있는지 (수직 벽 제어)
+// 게이트는 로드 시 위상 순서로 정렬되므로 한 번 훑으면 네트워크 전체가 평가됨
+#define MAX_LOGIC_GATES 32
+#define MAX_LOGIC_INPUTS 8
+#define LOGIC_MAX_SIGNALS 64
+#define LOGIC_PLANE_COUNT 2
+
+typedef enum {
+    LOGIC_AND,      // 입력이 모두 켜짐
+    LOGIC_OR,       // 입력이 하나라도 켜짐
+    LOGIC_XOR,      // 켜진 입력이 홀수 개
+    LOGIC_NOT,      // 입력이 모두 꺼짐 (입력이 여럿이면 NOR)
+    LOGIC_LATCH,    // 입력이 꺼진 뒤에도 param 틱 동안 켜짐 유지
+    LOGIC_COUNTER   // 입력이 param 번 켜지면 켜진 채로 유지
+} LogicOp;
+
+// # GROUPS에서 읽은 게이트 정의 (입력은 이름, 신호 비트는 호출자가 채움)
+// 형식: AND|OR|XOR|NOT 이름 입력... / LATCH|COUNTER 이름 틱수|횟수 입력...
+typedef struct {
+    LogicOp op;
+    char name[32];
+    int param;
+    int input_count;
+    char input_names[MAX_LOGIC_INPUTS][32];
+    int output;         // 출력 신호 비트
+    uint64_t inputs;    // 입력 신호 비트마스크
+} LogicGateDef;
+
+// 컴파일된 네트워크 (평가 순서대로 저장)
+typedef struct {
+    int gate_count;
+    struct {
+        uint8_t op;         // LogicOp
+        uint8_t output;     // 출력 신호 비트
+        int param;
+        uint64_t inputs;    // 입력 신호 비트마스크
+        int state[LOGIC_PLANE_COUNT];       // LATCH: 남은 틱, COUNTER: 켜진 횟수
+        bool last_input[LOGIC_PLANE_COUNT]; // COUNTER 상승 에지 검출용
+    } gates[MAX_LOGIC_GATES];
+    bool timers_active;     // 남은 시간이 있는 LATCH가 있으면 입력이 그대로여도 매 틱 평가
+} LogicNetwork;
+
+// 게이트 정의 줄이면 파싱해서 true (S/X/T/V 등 다른 줄이면 false)
+bool logic_parse_gate(const char* line, LogicGateDef* def);
+
+// 정의를 위상 순서로 정렬해 네트워크로 컴파일 (입력 마스크가 0이거나 순환에 걸린 게이트는 빠지고 출력은 꺼진 채로 남음)
+// 반환값: 컴파일된 게이트 수
+int logic_compile(LogicNetwork* net, const LogicGateDef* defs, int def_count);
+
+// 네트워크 평가 (bits의 게이트 출력 비트를 갱신)
+void logic_evaluate(LogicNetwork* net, uint64_t bits[LOGIC_PLANE_COUNT]);
+
+#endif // LOGIC_H
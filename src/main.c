@@ -6,6 +6,14 @@
 #include "player.h"
 #include "menu.h"
 #include "ranking.h"
+#include "profiler.h"
+#include "trace.h"
+#include "metrics.h"
+#include "stage_loader.h"
+#include "timer.h"
+#include "simulation.h"
+#include "bench.h"
+#include "replay.h"
 
 #ifdef __APPLE__
     #include <sys/wait.h>
@@ -35,6 +43,20 @@ static int get_text_display_width(const char* str) {
 static int current_stage = 1;
 #define MAX_STAGE 3
 
+// 시뮬레이션/렌더링 주기 (명령행으로 각각 설정)
+#define DEFAULT_TICK_RATE 20    // 물리 틱 (Hz)
+#define DEFAULT_RENDER_RATE 20  // 화면 갱신 (Hz)
+#define MAX_CATCHUP_NS 250000000ULL // 한 프레임에서 따라잡을 최대 시뮬레이션 시간
+static int sim_tick_rate = DEFAULT_TICK_RATE;
+static int render_rate = DEFAULT_RENDER_RATE;
+
+// 입력 기록/재생 파일 (명령행으로 지정)
+static const char* record_filename = NULL;
+static const char* replay_filename = NULL;
+
+// 단계별 히스토그램 저장 파일 (--profile로 지정했을 때만 저장)
+static const char* profile_filename = NULL;
+
 // 음악 재생 프로세스 ID (macOS에서만 사용)
 #ifdef __APPLE__
     static pid_t music_pid = 0;
@@ -100,32 +122,35 @@ void music_stop(void) {
 #endif
 }
 
-// 스테이지 파일 경로 생성
-static void get_stage_filename(int stage_id, char* buffer, size_t buffer_size) {
-    snprintf(buffer, buffer_size, "stages/stage%d.txt", stage_id);
-}
-
-// 스테이지 로드 및 초기화
-static bool load_stage(int stage_id, Map** map, Player* fireboy, Player* watergirl, 
-                       int* prev_fireboy_x, int* prev_fireboy_y,
-                       int* prev_watergirl_x, int* prev_watergirl_y) {
-    char stage_file[256];
-    get_stage_filename(stage_id, stage_file, sizeof(stage_file));
+// 스테이지 맵 준비 (화면/플레이어는 건드리지 않음)
+// 로더 스레드가 미리 읽어 둔 맵이 있으면 포인터만 가져오고, 없으면 직접 파일을 읽음
+// (로더가 오류/경고로 버린 맵도 여기서 다시 읽으므로 진단 메시지는 게임 스레드에서 출력됨)
+static Map* prepare_stage(int stage_id) {
+    trace_instant("stage_load", stage_id);
+    trace_begin("load_stage");
+    uint64_t load_start_ns = profiler_now_ns();
     
-    // 기존 맵 정리
-    if (*map) {
-        map_destroy(*map);
-    }
-    
-    // 새 맵 로드
-    *map = map_load_from_file(stage_file);
-    if (!*map) {
-        return false;
+    Map* new_map = stage_loader_take(stage_id);
+    if (new_map) {
+        metrics_add(METRIC_STAGE_PRELOAD_HITS, 1);
+    } else {
+        char stage_file[256];
+        stage_get_filename(stage_id, stage_file, sizeof(stage_file));
+        new_map = map_load_from_file(stage_file);
     }
     
+    metrics_set(METRIC_LOAD_STAGE_NS, profiler_now_ns() - load_start_ns);
+    trace_end("load_stage");
+    return new_map;
+}
+
+// 플레이어를 시작 위치에 배치하고 화면 전체를 다시 그리도록 초기화
+static void spawn_players(const Map* map, Player* fireboy, Player* watergirl,
+                          int* prev_fireboy_x, int* prev_fireboy_y,
+                          int* prev_watergirl_x, int* prev_watergirl_y) {
     // 플레이어 초기화
-    player_init(fireboy, PLAYER_FIREBOY, (*map)->fireboy_start_x, (*map)->fireboy_start_y);
-    player_init(watergirl, PLAYER_WATERGIRL, (*map)->watergirl_start_x, (*map)->watergirl_start_y);
+    player_init(fireboy, PLAYER_FIREBOY, map->fireboy_start_x, map->fireboy_start_y);
+    player_init(watergirl, PLAYER_WATERGIRL, map->watergirl_start_x, map->watergirl_start_y);
     
     // 이전 위치 추적 초기화
     *prev_fireboy_x = fireboy->x;
@@ -136,10 +161,231 @@ static bool load_stage(int stage_id, Map** map, Player* fireboy, Player* watergi
     // 렌더러 리셋
     renderer_reset();
     console_clear();
+}
+
+// 미리 읽어 둔 맵으로 교체하고 플레이어/렌더러 초기화
+static void install_stage(Map* new_map, int stage_id, Map** map, Player* fireboy, Player* watergirl,
+                          int* prev_fireboy_x, int* prev_fireboy_y,
+                          int* prev_watergirl_x, int* prev_watergirl_y) {
+    // 기존 맵 정리
+    if (*map) {
+        map_destroy(*map);
+    }
+    *map = new_map;
     
+    spawn_players(*map, fireboy, watergirl,
+                  prev_fireboy_x, prev_fireboy_y, prev_watergirl_x, prev_watergirl_y);
+    
+    metrics_set(METRIC_CURRENT_STAGE, (uint64_t)stage_id);
+    replay_record_stage(stage_id);
+    
+    // 이 스테이지를 하는 동안 다음 스테이지를 미리 읽어 둠
+    if (stage_id < MAX_STAGE) {
+        stage_loader_request(stage_id + 1);
+    }
+}
+
+// 스테이지 로드 및 초기화
+static bool load_stage(int stage_id, Map** map, Player* fireboy, Player* watergirl, 
+                       int* prev_fireboy_x, int* prev_fireboy_y,
+                       int* prev_watergirl_x, int* prev_watergirl_y) {
+    Map* new_map = prepare_stage(stage_id);
+    if (!new_map) {
+        return false;
+    }
+    install_stage(new_map, stage_id, map, fireboy, watergirl,
+                  prev_fireboy_x, prev_fireboy_y, prev_watergirl_x, prev_watergirl_y);
     return true;
 }
 
+// 스테이지 음악 재생
+static void play_stage_music(int stage_id) {
+    char music_file[256];
+    snprintf(music_file, sizeof(music_file), "assets/stage%d.mp3", stage_id);
+    music_play(music_file);
+}
+
+// HUD 표시 (마지막 줄)
+static void draw_hud(void) {
+    console_set_cursor_position(0, 29);
+    console_reset_color();
+    
+    // 보석 카운트 표시
+    int fire_gems = player_get_fire_gem_count();
+    int water_gems = player_get_water_gem_count();
+    int total_gems = player_get_total_gem_count();
+    int deaths = player_get_death_count();
+    
+    console_set_color(COLOR_RED, COLOR_BLACK);
+    printf("🔥F:%d", fire_gems);
+    console_reset_color();
+    printf(" ");
+    console_set_color(COLOR_CYAN, COLOR_BLACK);
+    printf("💧W:%d", water_gems);
+    console_reset_color();
+    printf(" 합:%d | ", total_gems);
+    
+    console_set_color(COLOR_YELLOW, COLOR_BLACK);
+    printf("사망:%d회", deaths);
+    console_reset_color();
+    printf(" | Stage:%d/%d | Fireboy:← → ↑ Watergirl:A D W ESC:종료", current_stage, MAX_STAGE);
+    // 공백으로 나머지 공간 채우기
+    for (int i = 0; i < 3; i++) printf(" ");
+}
+
+// 정지 상태에서 타이머 표시를 갱신하는 주기
+#define TIMER_HUD_REFRESH_MS 100
+
+// 타이머 표시 (HUD 바로 위 줄): 스테이지 시간, 전체 시간, 활성화된 구간 기록
+static void draw_timer_hud(const GameTimer* stage_timer, const GameTimer* run_timer, uint64_t now_ns) {
+    static const char* split_labels[SPLIT_COUNT] = { "스위치", "보석", "출구" };
+    char stage_text[16];
+    char run_text[16];
+    timer_format(timer_elapsed_ns(stage_timer, now_ns), stage_text, sizeof(stage_text));
+    timer_format(timer_elapsed_ns(run_timer, now_ns), run_text, sizeof(run_text));
+    
+    console_set_cursor_position(0, 28);
+    console_set_color(COLOR_WHITE, COLOR_BLACK);
+    printf("⏱ %8s | 전체 %8s", stage_text, run_text);
+    
+    for (int i = 0; i < SPLIT_COUNT; i++) {
+        if (!timer_is_split_enabled((SplitPoint)i)) continue;
+        uint64_t split_ns;
+        if (timer_get_split(stage_timer, (SplitPoint)i, &split_ns)) {
+            char split_text[16];
+            timer_format(split_ns, split_text, sizeof(split_text));
+            printf(" | %s %8s", split_labels[i], split_text);
+        } else {
+            printf(" | %s %8s", split_labels[i], "-");
+        }
+    }
+    console_reset_color();
+}
+
+// 스테이지 클리어 팝업 크기 및 위치 (완전 중앙 정렬)
+#define POPUP_WIDTH 52
+#define POPUP_HEIGHT 8
+#define POPUP_X ((80 - POPUP_WIDTH) / 2)
+#define POPUP_Y ((25 - POPUP_HEIGHT) / 2)
+
+// 스테이지 전환 시간
+#define STAGE_CLEAR_POPUP_MS 3000
+#define DEATH_MESSAGE_MS 500
+
+// 스테이지 클리어 팝업 그리기
+static void draw_stage_clear_popup(const GameTimer* stage_timer, int deaths, int fire_gems, int water_gems, int total_gems) {
+    int box_width = POPUP_WIDTH;
+    int box_height = POPUP_HEIGHT;
+    int start_x = POPUP_X;
+    int start_y = POPUP_Y;
+    
+    // 배경색이 있는 박스 그리기
+    console_set_color(COLOR_BLACK, COLOR_WHITE);
+    
+    // 상단 테두리
+    console_set_cursor_position(start_x, start_y);
+    printf("╔");
+    for (int i = 0; i < box_width - 2; i++) printf("═");
+    printf("╗");
+    
+    // 빈 줄들 (배경색)
+    for (int y = 1; y < box_height - 1; y++) {
+        console_set_cursor_position(start_x, start_y + y);
+        printf("║");
+        for (int i = 0; i < box_width - 2; i++) printf(" ");
+        printf("║");
+    }
+    
+    // 하단 테두리
+    console_set_cursor_position(start_x, start_y + box_height - 1);
+    printf("╚");
+    for (int i = 0; i < box_width - 2; i++) printf("═");
+    printf("╝");
+    
+    // 내용 출력 (완전 중앙 정렬)
+    // 타이틀
+    char title[] = "🎉 스테이지 클리어! 🎉";
+    int title_width = get_text_display_width(title);
+    console_set_cursor_position(start_x + (box_width - title_width) / 2, start_y + 1);
+    console_set_color(COLOR_GREEN, COLOR_WHITE);
+    console_set_attribute(ATTR_BOLD);
+    printf("%s", title);
+    
+    // 시간 및 사망 (타이머는 출구 도착 시점에 멈춰 있음)
+    char elapsed_text[16];
+    timer_format(timer_elapsed_ns(stage_timer, 0), elapsed_text, sizeof(elapsed_text));
+    char time_line[64];
+    snprintf(time_line, sizeof(time_line), "시간: %s초 | 사망: %d회", elapsed_text, deaths);
+    int time_width = get_text_display_width(time_line);
+    console_set_cursor_position(start_x + (box_width - time_width) / 2, start_y + 3);
+    console_set_color(COLOR_BLACK, COLOR_WHITE);
+    printf("%s", time_line);
+    
+    // 보석 정보
+    char gem_line[128];
+    snprintf(gem_line, sizeof(gem_line), "🔥 Fire 보석: %d | 💧 Water 보석: %d | 합계: %d", 
+             fire_gems, water_gems, total_gems);
+    int gem_width = get_text_display_width(gem_line);
+    console_set_cursor_position(start_x + (box_width - gem_width) / 2, start_y + 4);
+    console_set_color(COLOR_RED, COLOR_WHITE);
+    printf("🔥 Fire 보석: %d", fire_gems);
+    console_set_color(COLOR_BLACK, COLOR_WHITE);
+    printf(" | ");
+    console_set_color(COLOR_CYAN, COLOR_WHITE);
+    printf("💧 Water 보석: %d", water_gems);
+    console_set_color(COLOR_BLACK, COLOR_WHITE);
+    printf(" | ");
+    console_set_color(COLOR_BLACK, COLOR_WHITE);
+    printf("합계: %d", total_gems);
+    
+    // 구간 기록 (출구 제외, 기록된 것만)
+    char split_line[96];
+    int split_len = 0;
+    split_line[0] = '\0';
+    for (int i = 0; i < SPLIT_EXIT; i++) {
+        uint64_t split_ns;
+        if (!timer_get_split(stage_timer, (SplitPoint)i, &split_ns)) continue;
+        char split_text[16];
+        timer_format(split_ns, split_text, sizeof(split_text));
+        split_len += snprintf(split_line + split_len, sizeof(split_line) - split_len, "%s%s %s초",
+                              split_len > 0 ? " | " : "",
+                              i == SPLIT_FIRST_SWITCH ? "첫 스위치" : "보석 완료", split_text);
+    }
+    if (split_len > 0) {
+        console_set_cursor_position(start_x + (box_width - get_text_display_width(split_line)) / 2, start_y + 5);
+        console_set_color(COLOR_BLACK, COLOR_WHITE);
+        printf("%s", split_line);
+    }
+    
+    console_reset_color();
+}
+
+// 스테이지 클리어 팝업의 남은 시간 막대 (progress: 0.0 ~ 1.0)
+static void draw_stage_clear_progress(float progress) {
+    const int bar_width = 20;
+    int filled = (int)(progress * bar_width + 0.5f);
+    if (filled > bar_width) filled = bar_width;
+    
+    char hint[] = " Enter: 계속";
+    int line_width = bar_width + get_text_display_width(hint);
+    console_set_cursor_position(POPUP_X + (POPUP_WIDTH - line_width) / 2, POPUP_Y + 6);
+    console_set_color(COLOR_GREEN, COLOR_WHITE);
+    for (int i = 0; i < filled; i++) printf("█");
+    console_set_color(COLOR_BLACK, COLOR_WHITE);
+    for (int i = filled; i < bar_width; i++) printf("░");
+    printf("%s", hint);
+    console_reset_color();
+}
+
+// 사망 메시지 표시 (화면 중앙)
+static void draw_death_message(int deaths) {
+    console_set_cursor_position(20, 15);
+    console_set_color(COLOR_RED, COLOR_BLACK);
+    console_set_attribute(ATTR_BOLD);
+    printf("죽었습니다.. 사망 횟수: %d ", deaths);
+    console_reset_color();
+}
+
 // 게임 초기화
 void game_init(void) {
     console_init();
@@ -156,6 +402,13 @@ void game_cleanup(void) {
     input_cleanup();
 }
 
+// 게임 진행 상태 (스테이지 전환은 메인 루프 안의 시간 제한 상태로 처리)
+typedef enum {
+    GAME_STATE_PLAYING,      // 플레이 중
+    GAME_STATE_STAGE_CLEAR,  // 스테이지 클리어 팝업 표시 중
+    GAME_STATE_DEATH         // 사망 메시지 표시 중
+} GameState;
+
 // 게임 루프 (4단계: 캐릭터 기본 이동)
 void game_loop(const char* player_name) {
     console_clear();
@@ -163,18 +416,35 @@ void game_loop(const char* player_name) {
     // 스테이지 초기화
     current_stage = 1;
     
+    // 재생 모드: 기록된 스테이지와 틱 주기로 시작 (틱 주기가 다르면 결과가 달라짐)
+    if (replay_filename) {
+        ReplayHeader header;
+        if (!replay_play_start(replay_filename, &header) ||
+            header.stage_id < 1 || header.stage_id > MAX_STAGE || header.tick_rate < 1) {
+            replay_play_stop();
+            printf("재생 파일을 열 수 없습니다: %s\n", replay_filename);
+            return;
+        }
+        current_stage = header.stage_id;
+        sim_tick_rate = header.tick_rate;
+        if (header.build_hash != replay_build_hash()) {
+            printf("경고: 다른 빌드에서 기록된 파일입니다 (결과가 다를 수 있음)\n");
+        }
+    } else if (record_filename && !replay_record_start(record_filename, current_stage, sim_tick_rate)) {
+        printf("기록 파일을 만들 수 없습니다: %s\n", record_filename);
+    }
+    
     printf("=== 게임 시작 ===\n\n");
     printf("맵 파일 로딩 중...\n");
     
-    // 맵 파일 경로 저장 (사망 시 맵 리로드용)
-    char map_file_path[256];
-    get_stage_filename(current_stage, map_file_path, sizeof(map_file_path));
-    
     Map* map = NULL;
     Player fireboy, watergirl;
     int prev_fireboy_x, prev_fireboy_y;
     int prev_watergirl_x, prev_watergirl_y;
     
+    // 다음 스테이지 미리 읽기용 로더 스레드 (실패하면 전환 시 동기 로드)
+    stage_loader_start();
+    
     // 첫 스테이지 로드
     if (!load_stage(current_stage, &map, &fireboy, &watergirl, 
                     &prev_fireboy_x, &prev_fireboy_y,
@@ -188,6 +458,7 @@ void game_loop(const char* player_name) {
                 break;
             }
         }
+        stage_loader_stop();
         return;
     }
     
@@ -195,16 +466,14 @@ void game_loop(const char* player_name) {
     printf("Enter 키를 눌러 게임을 시작하세요...\n");
     
     // 맵 로드 성공 후 스테이지 음악 재생
-    char music_file[256];
-    snprintf(music_file, sizeof(music_file), "assets/stage%d.mp3", current_stage);
-    music_play(music_file);
+    play_stage_music(current_stage);
     
     // 게임 시작 시 보석 개수 리셋
     player_reset_gem_count();
     player_reset_death_count();
     
-    // 입력 대기
-    while (!input_is_quit_requested()) {
+    // 입력 대기 (재생 모드는 바로 시작)
+    while (!replay_is_playing() && !input_is_quit_requested()) {
         input_update();
         if (input_get_player_input().fireboy.enter || 
             input_get_player_input().watergirl.enter) {
@@ -219,329 +488,523 @@ void game_loop(const char* player_name) {
     int camera_x = 0;
     int camera_y = 0;
     
-    // 프레임 타이밍
-    float delta_time = 0.05f; // 50ms = 0.05초 (고정 프레임)
+    // 프레임 타이밍: 시뮬레이션은 고정 간격으로 누적 실행하고, 화면은 렌더링 주기마다 그림
+    float sim_delta_time = 1.0f / (float)sim_tick_rate;
+    uint64_t sim_tick_ns = 1000000000ULL / (uint64_t)sim_tick_rate;
+    uint64_t frame_interval_ns = 1000000000ULL / (uint64_t)render_rate;
+    uint64_t sim_accumulator_ns = 0;
+    uint64_t sim_clock_ns = timer_now_ns(); // 시뮬레이션이 도달한 시각 (이후 입력은 해당 틱에서 반영)
     
-    // 게임 타이머 시작
-    time_t game_start_time = time(NULL);
-    time_t total_game_start_time = time(NULL); // 전체 게임 시작 시간
+    // 게임 타이머 시작 (스테이지 타이머 + 스테이지 전환 중에는 멈추는 전체 타이머)
+    GameTimer stage_timer;
+    GameTimer run_timer;
+    uint64_t game_start_ns = timer_now_ns();
+    timer_start(&stage_timer, game_start_ns);
+    timer_start(&run_timer, game_start_ns);
     
     // 각 스테이지별 클리어 시간 저장
     float stage_times[3] = {0.0f, 0.0f, 0.0f};
     
+    // 스테이지 전환 상태
+    GameState state = GAME_STATE_PLAYING;
+    uint64_t transition_start_ns = 0;
+    Map* pending_map = NULL; // 스테이지 클리어 팝업이 끝나면 교체할 다음 스테이지 맵
+    
+    // 직전 틱의 정지 상태 (유휴 프레임 생략용)
+    bool was_quiescent = false;
+    
+    // 초당 출력 바이트 계산용
+    uint64_t rate_window_start_ns = profiler_now_ns();
+    uint64_t rate_window_bytes = metrics_get(METRIC_RENDER_BYTES);
+    
+    // 프레임 단계별 프로파일러 초기화
+    profiler_init();
+    
+    uint64_t last_frame_ns = timer_now_ns();
+    uint64_t next_frame_ns = last_frame_ns;
+    
     // 게임 루프
     while (!input_is_quit_requested()) {
-        input_update();
+        trace_begin("tick");
+        uint64_t tick_start_ns = profiler_now_ns();
+        uint64_t tick_time_ns = timer_now_ns(); // 이 프레임의 게임 시각 (타이머/구간 기록 기준)
+        uint64_t frame_elapsed_ns = tick_time_ns - last_frame_ns;
+        last_frame_ns = tick_time_ns;
+        metrics_add(METRIC_TICKS, 1);
+        
+        // 플레이 중에는 시뮬레이션이 도달한 시각까지만 반영 (이후 입력은 그 시각의 틱에서 반영)
+        // (재생 중에는 키보드 입력이 시뮬레이션에 들어가지 않으므로 모두 반영)
+        bool per_tick_input = state == GAME_STATE_PLAYING && !replay_is_playing();
+        uint64_t input_deadline_ns = per_tick_input ? sim_clock_ns : tick_time_ns;
+        profiler_begin(PROF_INPUT);
+        input_update_until(input_deadline_ns);
+        profiler_end(PROF_INPUT);
+        sim_clock_ns = input_deadline_ns;
+        
+        // 입력 가져오기
+        PlayerInput input = input_get_player_input();
         
         // ESC로 종료
-        if (input_get_player_input().fireboy.escape) {
+        if (input.fireboy.escape) {
+            trace_end("tick"); // 루프를 빠져나갈 때도 tick 구간을 닫음 (trace 파일의 B/E 짝 맞춤)
             break;
         }
         
-        // 디버그용: 숫자키로 스테이지 전환
-        int stage_key = input_get_stage_key();
-        if (stage_key >= 1 && stage_key <= 3) {
-            int target_stage = stage_key;
-            if (target_stage != current_stage && target_stage <= MAX_STAGE) {
-                current_stage = target_stage;
-                get_stage_filename(current_stage, map_file_path, sizeof(map_file_path));
-                if (load_stage(current_stage, &map, &fireboy, &watergirl,
-                              &prev_fireboy_x, &prev_fireboy_y,
-                              &prev_watergirl_x, &prev_watergirl_y)) {
-                    // 스테이지 음악 재생
-                    char music_file[256];
-                    snprintf(music_file, sizeof(music_file), "assets/stage%d.mp3", current_stage);
-                    music_play(music_file);
-                    
-                    game_start_time = time(NULL); // 타이머 리셋
-                    render_map_no_flicker_with_players(map, camera_x, camera_y,
-                                                      fireboy.x, fireboy.y,
-                                                      watergirl.x, watergirl.y);
-                    render_player(&fireboy, camera_x, camera_y);
-                    render_player(&watergirl, camera_x, camera_y);
-                }
+        // 디버그용: P 키로 프로파일러 오버레이 토글 (재생 중에는 ESC만 받음)
+        if (input_get_profiler_key() && !replay_is_playing()) {
+            profiler_toggle_overlay();
+            if (!profiler_is_overlay_visible()) {
+                renderer_reset(); // 오버레이가 덮었던 영역을 다시 그리도록
             }
+            was_quiescent = false;
         }
         
-        // 입력 가져오기
-        PlayerInput input = input_get_player_input();
-        
-        // 맵 오브젝트 업데이트
-        map_update_boxes(map, delta_time);
-        map_update_switches(map, fireboy.x, fireboy.y, watergirl.x, watergirl.y);
-        map_update_platforms(map, delta_time, (struct Player*)&fireboy, (struct Player*)&watergirl);
-        map_update_toggle_platforms(map, delta_time);
-        map_update_vertical_walls(map, delta_time);
+        bool quiescent = false;
         
-        // 플레이어 업데이트 (물리 시스템 포함)
-        player_update(&fireboy, map, input.fireboy.left, input.fireboy.right, input.fireboy.jump, delta_time);
-        player_update(&watergirl, map, input.watergirl.left, input.watergirl.right, input.watergirl.jump, delta_time);
-        
-        // Exit 도착 체크 (두 플레이어 모두 도착해야 함)
-        bool fireboy_at_exit = (fireboy.x == map->exit_x && fireboy.y == map->exit_y);
-        bool watergirl_at_exit = (watergirl.x == map->exit_x && watergirl.y == map->exit_y);
-        
-        if (fireboy_at_exit && watergirl_at_exit) {
-            // 스테이지 클리어!
-            time_t game_end_time = time(NULL);
-            float elapsed_time = (float)(game_end_time - game_start_time);
-            int deaths = player_get_death_count();
-            int fire_gems = player_get_fire_gem_count();
-            int water_gems = player_get_water_gem_count();
-            int total_gems = player_get_total_gem_count();
-            
-            // 현재 스테이지 시간 저장
-            stage_times[current_stage - 1] = elapsed_time;
+        if (state != GAME_STATE_PLAYING) {
+            // 스테이지 전환 중: 시간이 다 되거나 Enter를 누르면 다음 상태로
+            uint64_t duration_ms = (state == GAME_STATE_STAGE_CLEAR) ? STAGE_CLEAR_POPUP_MS : DEATH_MESSAGE_MS;
+            uint64_t elapsed_ms = (profiler_now_ns() - transition_start_ns) / 1000000ULL;
+            bool skipped = input.fireboy.enter || input.watergirl.enter;
             
-            // 팝업 박스 크기 및 위치 계산 (완전 중앙 정렬)
-            int box_width = 52;
-            int box_height = 7;
-            int start_x = (80 - box_width) / 2;
-            int start_y = (25 - box_height) / 2;
-            
-            // 배경색이 있는 박스 그리기
-            console_set_color(COLOR_BLACK, COLOR_WHITE);
-            
-            // 상단 테두리
-            console_set_cursor_position(start_x, start_y);
-            printf("╔");
-            for (int i = 0; i < box_width - 2; i++) printf("═");
-            printf("╗");
-            
-            // 빈 줄들 (배경색)
-            for (int y = 1; y < box_height - 1; y++) {
-                console_set_cursor_position(start_x, start_y + y);
-                printf("║");
-                for (int i = 0; i < box_width - 2; i++) printf(" ");
-                printf("║");
+            if (elapsed_ms < duration_ms && !skipped) {
+                if (state == GAME_STATE_STAGE_CLEAR) {
+                    // 남은 시간 막대 애니메이션
+                    draw_stage_clear_progress(1.0f - (float)elapsed_ms / (float)duration_ms);
+                    fflush(stdout);
+                }
+            } else if (state == GAME_STATE_STAGE_CLEAR) {
+                // 마지막 스테이지인지 확인
+                if (current_stage >= MAX_STAGE) {
+                    // 총 게임 시간 (스테이지 클리어 팝업 시간 제외)
+                    float total_elapsed_time = (float)(timer_elapsed_ns(&run_timer, tick_time_ns) / 1e9);
+                    int deaths = player_get_death_count();
+                    
+                    // 랭킹 저장
+                    if (player_name && strlen(player_name) > 0) {
+                        uint64_t save_start_ns = profiler_now_ns();
+                        RankingSystem ranking;
+                        ranking_load(&ranking, "rankings.dat");
+                        ranking_add_entry(&ranking, player_name, total_elapsed_time, deaths);
+                        ranking_save(&ranking, "rankings.dat");
+                        metrics_set(METRIC_RANKING_SAVE_NS, profiler_now_ns() - save_start_ns);
+                    }
+                    
+                    // 최종 결과 화면 표시
+                    menu_show_final_result(stage_times, total_elapsed_time, deaths,
+                                           player_get_fire_gem_count(), player_get_water_gem_count());
+                    
+                    // 게임 종료
+                    trace_end("tick");
+                    break;
+                }
+                
+                if (!pending_map) {
+                    // 다음 스테이지 로드 실패
+                    printf("다음 스테이지 로드 실패!\n");
+                    trace_end("tick");
+                    break;
+                }
+                
+                // 준비해 둔 다음 스테이지로 교체
+                current_stage++;
+                install_stage(pending_map, current_stage, &map, &fireboy, &watergirl,
+                              &prev_fireboy_x, &prev_fireboy_y,
+                              &prev_watergirl_x, &prev_watergirl_y);
+                pending_map = NULL;
+                
+                // 스테이지 음악 재생
+                play_stage_music(current_stage);
+                
+                // 타이머 리셋 (전체 타이머는 이어서 진행)
+                timer_start(&stage_timer, tick_time_ns);
+                timer_resume(&run_timer, tick_time_ns);
+                state = GAME_STATE_PLAYING;
+                was_quiescent = false;
+            } else {
+                // 보석 개수 리셋
+                player_reset_gem_count();
+                
+                // 로드 직후 스냅샷으로 맵 복원 (보석/상자/스위치 원래대로, 파일을 다시 읽지 않음)
+                trace_begin("respawn");
+                uint64_t respawn_start_ns = profiler_now_ns();
+                bool restored = map_reset(map);
+                metrics_set(METRIC_RESPAWN_NS, profiler_now_ns() - respawn_start_ns);
+                trace_end("respawn");
+                
+                if (restored) {
+                    spawn_players(map, &fireboy, &watergirl,
+                                  &prev_fireboy_x, &prev_fireboy_y,
+                                  &prev_watergirl_x, &prev_watergirl_y);
+                } else {
+                    // 스냅샷이 없으면 파일에서 다시 로드
+                    Map* reloaded = prepare_stage(current_stage);
+                    if (!reloaded) {
+                        printf("맵 리로드 실패!\n");
+                        trace_end("tick");
+                        break;
+                    }
+                    install_stage(reloaded, current_stage, &map, &fireboy, &watergirl,
+                                  &prev_fireboy_x, &prev_fireboy_y,
+                                  &prev_watergirl_x, &prev_watergirl_y);
+                }
+                
+                state = GAME_STATE_PLAYING;
+                was_quiescent = false;
+            }
+        } else {
+            // 디버그용: 숫자키로 스테이지 전환 (재생 중에는 기록과 어긋나므로 키를 버리기만 함)
+            int stage_key = input_get_stage_key();
+            if (stage_key >= 1 && stage_key <= 3 && !replay_is_playing()) {
+                int target_stage = stage_key;
+                if (target_stage != current_stage && target_stage <= MAX_STAGE) {
+                    current_stage = target_stage;
+                    if (load_stage(current_stage, &map, &fireboy, &watergirl,
+                                  &prev_fireboy_x, &prev_fireboy_y,
+                                  &prev_watergirl_x, &prev_watergirl_y)) {
+                        // 스테이지 음악 재생
+                        play_stage_music(current_stage);
+                        
+                        timer_start(&stage_timer, tick_time_ns); // 타이머 리셋
+                        was_quiescent = false;
+                    }
+                }
             }
             
-            // 하단 테두리
-            console_set_cursor_position(start_x, start_y + box_height - 1);
-            printf("╚");
-            for (int i = 0; i < box_width - 2; i++) printf("═");
-            printf("╝");
-            
-            // 내용 출력 (완전 중앙 정렬)
-            // 타이틀
-            char title[] = "🎉 스테이지 클리어! 🎉";
-            int title_width = get_text_display_width(title);
-            console_set_cursor_position(start_x + (box_width - title_width) / 2, start_y + 1);
-            console_set_color(COLOR_GREEN, COLOR_WHITE);
-            console_set_attribute(ATTR_BOLD);
-            printf("%s", title);
-            
-            // 시간 및 사망
-            char time_line[64];
-            snprintf(time_line, sizeof(time_line), "시간: %.1f초 | 사망: %d회", elapsed_time, deaths);
-            int time_width = get_text_display_width(time_line);
-            console_set_cursor_position(start_x + (box_width - time_width) / 2, start_y + 3);
-            console_set_color(COLOR_BLACK, COLOR_WHITE);
-            printf("%s", time_line);
-            
-            // 보석 정보
-            char gem_line[128];
-            snprintf(gem_line, sizeof(gem_line), "🔥 Fire 보석: %d | 💧 Water 보석: %d | 합계: %d", 
-                     fire_gems, water_gems, total_gems);
-            int gem_width = get_text_display_width(gem_line);
-            console_set_cursor_position(start_x + (box_width - gem_width) / 2, start_y + 4);
-            console_set_color(COLOR_RED, COLOR_WHITE);
-            printf("🔥 Fire 보석: %d", fire_gems);
-            console_set_color(COLOR_BLACK, COLOR_WHITE);
-            printf(" | ");
-            console_set_color(COLOR_CYAN, COLOR_WHITE);
-            printf("💧 Water 보석: %d", water_gems);
-            console_set_color(COLOR_BLACK, COLOR_WHITE);
-            printf(" | ");
-            console_set_color(COLOR_BLACK, COLOR_WHITE);
-            printf("합계: %d", total_gems);
-            
-            console_reset_color();
-            fflush(stdout);
+            // 고정 간격 시뮬레이션: 지난 프레임 이후 흐른 시간만큼 틱 실행
+            sim_accumulator_ns += frame_elapsed_ns;
+            if (sim_accumulator_ns > MAX_CATCHUP_NS) {
+                sim_accumulator_ns = MAX_CATCHUP_NS;
+            }
             
-            usleep(3000000);
+            bool stage_cleared = false;
+            bool player_died = false;
+            uint64_t event_time_ns = tick_time_ns; // 클리어/사망이 일어난 틱의 시각
+            int sim_ticks = 0;
+            ReplayStep replay_step = REPLAY_TICK; // 재생 중 틱 대신 나온 레코드
+            int replay_stage = current_stage;
             
-            // 마지막 스테이지인지 확인
-            if (current_stage >= MAX_STAGE) {
-                // 총 게임 시간 계산
-                time_t total_game_end_time = time(NULL);
-                float total_elapsed_time = (float)(total_game_end_time - total_game_start_time);
+            while (sim_accumulator_ns >= sim_tick_ns) {
+                sim_accumulator_ns -= sim_tick_ns;
+                uint64_t sim_time_ns = tick_time_ns - sim_accumulator_ns; // 이 틱이 끝나는 시각
                 
-                // 랭킹 저장
-                if (player_name && strlen(player_name) > 0) {
-                    RankingSystem ranking;
-                    ranking_load(&ranking, "rankings.dat");
-                    ranking_add_entry(&ranking, player_name, total_elapsed_time, deaths);
-                    ranking_save(&ranking, "rankings.dat");
+                // 이 틱이 끝나는 시각까지 들어온 입력만 반영 (틱이 없는 프레임의 입력은 큐에 남음)
+                // 재생 중에는 기록된 입력 사용 (현재 스테이지 시작 레코드는 건너뜀)
+                PlayerInput sim_input;
+                if (replay_is_playing()) {
+                    while ((replay_step = replay_play_next(&sim_input, &replay_stage)) == REPLAY_STAGE &&
+                           replay_stage == current_stage) {}
+                    if (replay_step != REPLAY_TICK) {
+                        sim_accumulator_ns += sim_tick_ns; // 실행하지 않은 틱
+                        break;
+                    }
+                } else {
+                    input_update_until(sim_time_ns);
+                    sim_input = input_get_player_input();
                 }
+                replay_record_tick(&sim_input);
+                sim_clock_ns = sim_time_ns;
                 
-                // 최종 결과 화면 표시
-                menu_show_final_result(stage_times, total_elapsed_time, deaths, fire_gems, water_gems);
+                // 맵 오브젝트와 플레이어 업데이트
+                simulation_step(map, &fireboy, &watergirl, &sim_input, sim_delta_time);
+                sim_ticks++;
                 
-                // 게임 종료
-                break;
-            } else {
-                // 다음 스테이지로 이동
-                current_stage++;
-                get_stage_filename(current_stage, map_file_path, sizeof(map_file_path));
+                // 구간 기록
+                if (map_any_switch_activated(map)) {
+                    timer_split(&stage_timer, SPLIT_FIRST_SWITCH, sim_time_ns);
+                }
+                if (map_all_gems_collected(map)) {
+                    timer_split(&stage_timer, SPLIT_ALL_GEMS, sim_time_ns);
+                }
                 
-                if (load_stage(current_stage, &map, &fireboy, &watergirl,
-                              &prev_fireboy_x, &prev_fireboy_y,
-                              &prev_watergirl_x, &prev_watergirl_y)) {
-                    // 스테이지 음악 재생
-                    char music_file[256];
-                    snprintf(music_file, sizeof(music_file), "assets/stage%d.mp3", current_stage);
-                    music_play(music_file);
-                    
-                    game_start_time = time(NULL); // 타이머 리셋
-                    
-                    // 화면 다시 그리기
-                    render_map_no_flicker_with_players(map, camera_x, camera_y,
-                                                      fireboy.x, fireboy.y,
-                                                      watergirl.x, watergirl.y);
-                    render_player(&fireboy, camera_x, camera_y);
-                    render_player(&watergirl, camera_x, camera_y);
-                } else {
-                    // 다음 스테이지 로드 실패
-                    printf("다음 스테이지 로드 실패!\n");
+                // Exit 도착 체크 (두 플레이어 모두 도착해야 함)
+                bool fireboy_at_exit = (fireboy.x == map->exit_x && fireboy.y == map->exit_y);
+                bool watergirl_at_exit = (watergirl.x == map->exit_x && watergirl.y == map->exit_y);
+                if (fireboy_at_exit && watergirl_at_exit) {
+                    stage_cleared = true;
+                } else if (fireboy.state == PLAYER_STATE_DEAD || watergirl.state == PLAYER_STATE_DEAD) {
+                    player_died = true;
+                }
+                if (stage_cleared || player_died) {
+                    event_time_ns = sim_time_ns;
+                    sim_accumulator_ns = 0; // 전환 중에는 남은 시간을 버림
                     break;
                 }
             }
-        }
-        
-        // 사망 체크
-        if (fireboy.state == PLAYER_STATE_DEAD || watergirl.state == PLAYER_STATE_DEAD) {
-            // 사망 횟수 증가
-            player_increment_death_count();
-            int deaths = player_get_death_count();
+            metrics_add(METRIC_SIM_TICKS, (uint64_t)sim_ticks);
             
-            // 화면 중앙에 사망 메시지 표시
-            console_set_cursor_position(20, 15);
-            console_set_color(COLOR_RED, COLOR_BLACK);
-            console_set_attribute(ATTR_BOLD);
-            printf("죽었습니다.. 사망 횟수: %d ", deaths);
-            console_reset_color();
-            fflush(stdout);
+            // 재생: 기록된 스테이지 전환을 따라가고, 파일이 끝나면 종료
+            if (replay_step == REPLAY_END) {
+                trace_end("tick");
+                break;
+            }
+            if (replay_step == REPLAY_STAGE && replay_stage >= 1 && replay_stage <= MAX_STAGE) {
+                current_stage = replay_stage;
+                if (load_stage(current_stage, &map, &fireboy, &watergirl,
+                               &prev_fireboy_x, &prev_fireboy_y,
+                               &prev_watergirl_x, &prev_watergirl_y)) {
+                    play_stage_music(current_stage);
+                    timer_start(&stage_timer, tick_time_ns);
+                    sim_accumulator_ns = 0;
+                    was_quiescent = false;
+                }
+            }
             
-            usleep(500000);
+            // 발판은 마지막 두 시뮬레이션 상태 사이를 보간해서 그림
+            renderer_set_interpolation((float)sim_accumulator_ns / (float)sim_tick_ns);
             
-            // 보석 개수 리셋
-            player_reset_gem_count();
+            // 정지 상태 판정: 두 플레이어가 멈춰 있고 움직이는 오브젝트와 눌린 키가 없으면
+            // 이번 틱은 아무것도 바뀌지 않은 것이므로, 직전 틱도 정지 상태였다면 렌더링을 생략
+            quiescent = input_is_idle() && map_is_quiescent(map) &&
+                        player_is_at_rest(&fireboy) && player_is_at_rest(&watergirl);
+            bool frame_idle = quiescent && was_quiescent;
+            was_quiescent = quiescent;
             
-            // 현재 스테이지 다시 로드 (보석 복원)
-            if (!load_stage(current_stage, &map, &fireboy, &watergirl,
-                           &prev_fireboy_x, &prev_fireboy_y,
-                           &prev_watergirl_x, &prev_watergirl_y)) {
-                printf("맵 리로드 실패!\n");
-                break;
+            if (!frame_idle) {
+                profiler_begin(PROF_RENDER);
+                
+                // 플레이어가 이동한 경우 이전 위치의 타일 다시 그리기
+                if (prev_fireboy_x != fireboy.x || prev_fireboy_y != fireboy.y) {
+                    TileType tile = map_get_tile(map, prev_fireboy_x, prev_fireboy_y);
+                    int screen_x = (prev_fireboy_x - camera_x) * 2;
+                    int screen_y = prev_fireboy_y - camera_y;
+                    if (screen_x >= 0 && screen_x < 80 && screen_y >= 0 && screen_y < 29) {
+                        render_tile(tile, (prev_fireboy_x - camera_x), (prev_fireboy_y - camera_y));
+                    }
+                    prev_fireboy_x = fireboy.x;
+                    prev_fireboy_y = fireboy.y;
+                }
+                
+                if (prev_watergirl_x != watergirl.x || prev_watergirl_y != watergirl.y) {
+                    TileType tile = map_get_tile(map, prev_watergirl_x, prev_watergirl_y);
+                    int screen_x = (prev_watergirl_x - camera_x) * 2;
+                    int screen_y = prev_watergirl_y - camera_y;
+                    if (screen_x >= 0 && screen_x < 80 && screen_y >= 0 && screen_y < 29) {
+                        render_tile(tile, (prev_watergirl_x - camera_x), (prev_watergirl_y - camera_y));
+                    }
+                    prev_watergirl_x = watergirl.x;
+                    prev_watergirl_y = watergirl.y;
+                }
+                
+                // 맵 렌더링 (플레이어 위치 제외)
+                render_map_no_flicker_with_players(map, camera_x, camera_y,
+                                                  fireboy.x, fireboy.y,
+                                                  watergirl.x, watergirl.y);
+                
+                // 플레이어 렌더링
+                render_player(&fireboy, camera_x, camera_y);
+                render_player(&watergirl, camera_x, camera_y);
+                
+                // HUD 표시 (마지막 줄)
+                draw_hud();
+                draw_timer_hud(&stage_timer, &run_timer, tick_time_ns);
+                
+                profiler_end(PROF_RENDER);
+                
+                // 프로파일러 오버레이 (맵 오른쪽 위)
+                if (profiler_is_overlay_visible()) {
+                    profiler_draw_overlay(32, 1);
+                }
             }
             
-            // 화면 완전히 다시 그리기
-            renderer_reset(); // 렌더러 상태 리셋 (first_frame = true)
-            console_clear();
-            render_map_no_flicker_with_players(map, camera_x, camera_y,
-                                              fireboy.x, fireboy.y,
-                                              watergirl.x, watergirl.y);
-            render_player(&fireboy, camera_x, camera_y);
-            render_player(&watergirl, camera_x, camera_y);
-            
-            // HUD 다시 그리기
-            console_set_cursor_position(0, 29);
-            console_reset_color();
-            int fire_gems = player_get_fire_gem_count();
-            int water_gems = player_get_water_gem_count();
-            int total_gems = player_get_total_gem_count();
-            deaths = player_get_death_count(); // 이미 위에서 선언됨
+            if (stage_cleared) {
+                // 스테이지 클리어! (출구에 도착한 틱 시각으로 타이머 정지)
+                timer_split(&stage_timer, SPLIT_EXIT, event_time_ns);
+                timer_pause(&stage_timer, event_time_ns);
+                timer_pause(&run_timer, event_time_ns);
+                
+                // 현재 스테이지 시간 저장
+                stage_times[current_stage - 1] = (float)(timer_elapsed_ns(&stage_timer, event_time_ns) / 1e9);
+                
+                draw_stage_clear_popup(&stage_timer, player_get_death_count(),
+                                       player_get_fire_gem_count(), player_get_water_gem_count(),
+                                       player_get_total_gem_count());
+                draw_stage_clear_progress(1.0f);
+                
+                // 다음 스테이지 맵 준비 (보통은 로더 스레드가 이미 읽어 둔 맵을 가져옴)
+                if (current_stage < MAX_STAGE) {
+                    pending_map = prepare_stage(current_stage + 1);
+                }
+                
+                state = GAME_STATE_STAGE_CLEAR;
+                transition_start_ns = profiler_now_ns();
+                quiescent = false;
+            } else if (player_died) {
+                // 사망 횟수 증가
+                player_increment_death_count();
+                int deaths = player_get_death_count();
+                trace_instant("death", deaths);
+                metrics_add(METRIC_DEATHS, 1);
+                
+                // 화면 중앙에 사망 메시지 표시
+                draw_death_message(deaths);
+                
+                state = GAME_STATE_DEATH;
+                transition_start_ns = profiler_now_ns();
+                quiescent = false;
+            }
             
-            console_set_color(COLOR_RED, COLOR_BLACK);
-            printf("🔥F:%d", fire_gems);
-            console_reset_color();
-            printf(" ");
-            console_set_color(COLOR_CYAN, COLOR_BLACK);
-            printf("💧W:%d", water_gems);
-            console_reset_color();
-            printf(" 합:%d | ", total_gems);
+            if (frame_idle) {
+                // 맵은 그대로지만 타이머는 계속 흐르므로 타이머 줄만 갱신
+                draw_timer_hud(&stage_timer, &run_timer, tick_time_ns);
+            }
             
-            console_set_color(COLOR_YELLOW, COLOR_BLACK);
-            printf("사망:%d회", deaths);
-            console_reset_color();
-            printf(" | Stage:%d/%d | Fireboy:← → ↑ Watergirl:A D W ESC:종료", current_stage, MAX_STAGE);
-            for (int i = 0; i < 3; i++) printf(" ");
+            profiler_begin(PROF_FLUSH);
             fflush(stdout);
+            profiler_end(PROF_FLUSH);
         }
         
-        // 플레이어가 이동한 경우 이전 위치의 타일 다시 그리기
-        if (prev_fireboy_x != fireboy.x || prev_fireboy_y != fireboy.y) {
-            TileType tile = map_get_tile(map, prev_fireboy_x, prev_fireboy_y);
-            int screen_x = (prev_fireboy_x - camera_x) * 2;
-            int screen_y = prev_fireboy_y - camera_y;
-            if (screen_x >= 0 && screen_x < 80 && screen_y >= 0 && screen_y < 29) {
-                render_tile(tile, (prev_fireboy_x - camera_x), (prev_fireboy_y - camera_y));
-            }
-            prev_fireboy_x = fireboy.x;
-            prev_fireboy_y = fireboy.y;
+        trace_end("tick");
+        
+        // 프레임 예산 초과 및 초당 출력 바이트 집계
+        uint64_t tick_end_ns = profiler_now_ns();
+        if (tick_end_ns - tick_start_ns > frame_interval_ns) {
+            metrics_add(METRIC_FRAME_OVERRUNS, 1);
+        }
+        if (tick_end_ns - rate_window_start_ns >= 1000000000ULL) {
+            uint64_t bytes = metrics_get(METRIC_RENDER_BYTES);
+            metrics_set(METRIC_RENDER_BYTES_PER_SEC,
+                        (bytes - rate_window_bytes) * 1000000000ULL / (tick_end_ns - rate_window_start_ns));
+            rate_window_start_ns = tick_end_ns;
+            rate_window_bytes = bytes;
         }
         
-        if (prev_watergirl_x != watergirl.x || prev_watergirl_y != watergirl.y) {
-            TileType tile = map_get_tile(map, prev_watergirl_x, prev_watergirl_y);
-            int screen_x = (prev_watergirl_x - camera_x) * 2;
-            int screen_y = prev_watergirl_y - camera_y;
-            if (screen_x >= 0 && screen_x < 80 && screen_y >= 0 && screen_y < 29) {
-                render_tile(tile, (prev_watergirl_x - camera_x), (prev_watergirl_y - camera_y));
+        // 프레임 타이밍 (정지 상태면 다음 입력이 들어오거나 타이머 표시를 갱신할 때까지 대기)
+        trace_begin("sleep");
+        if (quiescent) {
+            input_wait(TIMER_HUD_REFRESH_MS);
+            next_frame_ns = timer_now_ns();
+        } else {
+            // 다음 렌더링 시각까지 대기 (작업 시간만큼 덜 잠, 밀렸으면 기준 시각을 다시 잡음)
+            next_frame_ns += frame_interval_ns;
+            uint64_t now_ns = timer_now_ns();
+            if (next_frame_ns > now_ns) {
+                usleep((useconds_t)((next_frame_ns - now_ns) / 1000ULL));
+            } else {
+                next_frame_ns = now_ns;
             }
-            prev_watergirl_x = watergirl.x;
-            prev_watergirl_y = watergirl.y;
         }
-        
-        // 맵 렌더링 (플레이어 위치 제외)
-        render_map_no_flicker_with_players(map, camera_x, camera_y,
-                                          fireboy.x, fireboy.y,
-                                          watergirl.x, watergirl.y);
-        
-        // 플레이어 렌더링
-        render_player(&fireboy, camera_x, camera_y);
-        render_player(&watergirl, camera_x, camera_y);
-        
-        // HUD 표시 (마지막 줄)
-        console_set_cursor_position(0, 29);
-        console_reset_color();
-        
-        // 보석 카운트 표시
-        int fire_gems = player_get_fire_gem_count();
-        int water_gems = player_get_water_gem_count();
-        int total_gems = player_get_total_gem_count();
-        int deaths = player_get_death_count();
-        
-        console_set_color(COLOR_RED, COLOR_BLACK);
-        printf("🔥F:%d", fire_gems);
-        console_reset_color();
-        printf(" ");
-        console_set_color(COLOR_CYAN, COLOR_BLACK);
-        printf("💧W:%d", water_gems);
-        console_reset_color();
-        printf(" 합:%d | ", total_gems);
-        
-        console_set_color(COLOR_YELLOW, COLOR_BLACK);
-        printf("사망:%d회", deaths);
-        console_reset_color();
-        printf(" | Stage:%d/%d | Fireboy:← → ↑ Watergirl:A D W ESC:종료", current_stage, MAX_STAGE);
-        // 공백으로 나머지 공간 채우기
-        for (int i = 0; i < 3; i++) printf(" ");
-        
-        fflush(stdout);
-        
-        // 프레임 타이밍
-        usleep(50000); // 50ms
+        trace_end("sleep");
     }
     
     // 정리
+    replay_record_stop();
+    replay_play_stop();
+    if (profile_filename) {
+        profiler_dump(profile_filename); // 단계별 히스토그램 저장
+    }
     music_stop(); // 게임 종료 시 음악 중지
+    stage_loader_stop();
+    if (pending_map) {
+        map_destroy(pending_map);
+    }
     map_destroy(map);
     renderer_cleanup();
 }
 
+// 사용법 출력
+static void print_usage(const char* program) {
+    printf("사용법: %s [--trace 파일] [--profile 파일] [--metrics 소켓경로] [--tick-rate HZ] [--render-rate HZ] [--splits 목록]\n", program);
+    printf("        %s [--record 파일 | --replay 파일] [--trace 파일] [--metrics 소켓경로] [--render-rate HZ]\n", program);
+    printf("        %s --bench 스테이지 [--ticks N] [--seed N] [--script 파일] [--tick-rate HZ] [--trace 파일]\n", program);
+    printf("  --trace 파일        게임 루프 구간을 기록해 종료 시 Chrome trace JSON으로 저장\n");
+    printf("  --profile 파일      게임 종료 시 프레임 단계별 시간 히스토그램을 저장\n");
+    printf("  --metrics 소켓경로  UNIX 소켓으로 Prometheus 형식 메트릭 제공\n");
+    printf("  --tick-rate HZ      물리 시뮬레이션 주기 (기본 %d)\n", DEFAULT_TICK_RATE);
+    printf("  --render-rate HZ    화면 갱신 주기 (기본 %d)\n", DEFAULT_RENDER_RATE);
+    printf("  --splits 목록       기록할 구간 (first_switch,all_gems,exit 중 쉼표로 구분, 또는 none)\n");
+    printf("  --record 파일       틱마다 시뮬레이션에 들어간 입력을 파일로 기록\n");
+    printf("  --replay 파일       메뉴 없이 기록된 입력으로 게임 진행 (ESC로 중단)\n");
+    printf("  --bench 스테이지    터미널 없이 시뮬레이션만 최대 속도로 실행하고 틱/초와 단계별 시간 출력\n");
+    printf("  --ticks N           벤치마크 틱 수 (기본 %d)\n", BENCH_DEFAULT_TICKS);
+    printf("  --seed N            무작위 입력 시드 (기본 1)\n");
+    printf("  --script 파일       무작위 대신 입력 스크립트 사용 (한 줄에 \"틱수 Fireboy키 Watergirl키\", 키는 L/R/J 조합 또는 -)\n");
+}
+
 // 메인 함수
-int main(void) {
+int main(int argc, char* argv[]) {
+    const char* trace_file = NULL;
+    const char* metrics_socket = NULL;
+    bool bench_mode = false;
+    BenchOptions bench = { 1, BENCH_DEFAULT_TICKS, 1, NULL, DEFAULT_TICK_RATE };
+    
+    // 명령행 인자 처리
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_file = argv[++i];
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profile_filename = argv[++i];
+        } else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            metrics_socket = argv[++i];
+        } else if (strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            sim_tick_rate = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--render-rate") == 0 && i + 1 < argc) {
+            render_rate = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--splits") == 0 && i + 1 < argc) {
+            unsigned split_mask;
+            if (!timer_parse_split_list(argv[++i], &split_mask)) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            timer_set_split_mask(split_mask);
+        } else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            bench_mode = true;
+            bench.stage_id = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            bench.ticks = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            bench.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            bench.script_file = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_filename = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_filename = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    
+    if (sim_tick_rate < 1 || sim_tick_rate > 1000 || render_rate < 1 || render_rate > 240) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (record_filename && replay_filename) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    bench.tick_rate = sim_tick_rate;
+    
+    // 트레이스 모드: 링 버퍼를 미리 할당
+    if (trace_file && !trace_init(TRACE_DEFAULT_CAPACITY)) {
+        printf("트레이스 버퍼 할당 실패!\n");
+        return 1;
+    }
+    
+    // 헤드리스 벤치마크 모드 (터미널 설정/메뉴 없이 바로 실행 후 종료)
+    if (bench_mode) {
+        if (bench.stage_id < 1 || bench.stage_id > MAX_STAGE || bench.ticks <= 0) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        int status = bench_run(&bench);
+        if (trace_file) {
+            trace_flush(trace_file);
+            trace_shutdown();
+        }
+        return status;
+    }
+    
+    // 메트릭 서버 (출력 바이트 집계 포함)
+    if (metrics_socket) {
+        if (!metrics_server_start(metrics_socket)) {
+            printf("메트릭 소켓을 열 수 없습니다: %s\n", metrics_socket);
+            return 1;
+        }
+        console_count_output();
+    }
+    
     game_init();
     
 #ifdef __APPLE__
@@ -552,18 +1015,23 @@ int main(void) {
     // 프로그램 시작 시 intro 음악 재생
     music_play("assets/intro.mp3");
     
-    // 메인 메뉴 루프
-    while (true) {
-        MenuResult result = menu_show_main();
-        
-        if (result.exit_game) {
-            break;
-        }
-        
-        if (result.start_game) {
-            game_loop(result.player_name);
-            // 게임 종료 후 메뉴로 돌아오면 intro 음악 다시 재생
-            music_play("assets/intro.mp3");
+    if (replay_filename) {
+        // 재생 모드: 메뉴 없이 기록된 입력으로 한 번 진행 후 종료
+        game_loop(NULL);
+    } else {
+        // 메인 메뉴 루프
+        while (true) {
+            MenuResult result = menu_show_main();
+            
+            if (result.exit_game) {
+                break;
+            }
+            
+            if (result.start_game) {
+                game_loop(result.player_name);
+                // 게임 종료 후 메뉴로 돌아오면 intro 음악 다시 재생
+                music_play("assets/intro.mp3");
+            }
         }
     }
     
@@ -571,6 +1039,14 @@ int main(void) {
     music_stop();
     game_cleanup();
     
+    metrics_server_stop();
+    
+    // 트레이스 저장
+    if (trace_file) {
+        trace_flush(trace_file);
+        trace_shutdown();
+    }
+    
     printf("\n프로그램을 종료합니다.\n");
     return 0;
 }
@@ -1,11 +1,237 @@
 #include "map.h"
 #include "player.h"
+#include "trace.h"
 #include <math.h>
+#include <stdarg.h>
 #include <string.h>
 
+// 로드 직후 상태 스냅샷 (구조체 전체 + 점유 색인과 타일 배열)
+struct MapSnapshot {
+    Map state;
+    uint8_t grid[];
+};
+
+// 점유 색인은 인덱스 + 1을 uint8_t에 담음
+_Static_assert(MAX_BOXES < 256 && MAX_SWITCHES < 256, "MapCell handles must fit in uint8_t");
+// 깨어 있는 상자 집합은 64비트 하나, 움직이는 벽 집합은 32비트 하나
+_Static_assert(MAX_BOXES <= 64, "awake_boxes must hold every box");
+_Static_assert(MAX_PLATFORMS <= 32, "moving_walls and subscriber masks must hold every platform/wall");
+// 빈 공간 평면은 map_create가 평면 배열 맨 앞을 1로 채워 만듦
+_Static_assert(MAP_PLANE_AIR == 0, "MAP_PLANE_AIR must be the first plane");
+
+// 타일 배열/점유 색인 원소 (범위 검사 없음, 맵 모듈 내부용)
+#define TILE_AT(map, x, y) ((map)->tiles[(size_t)(y) * (size_t)(map)->width + (size_t)(x)])
+#define CELL_AT(map, x, y) ((map)->cells[(size_t)(y) * (size_t)(map)->width + (size_t)(x)])
+
+// 지면 비트맵 워드 수
+static size_t map_footing_words(int width, int height) {
+    return ((size_t)width * (size_t)height + 63) / 64;
+}
+
+// 비트 평면 워드 수 (행 우선 평면 전체 + 열 우선 평면 전체)
+static size_t map_row_plane_words(int width, int height) {
+    return (size_t)MAP_PLANE_COUNT * (size_t)height * (((size_t)width + 63) / 64);
+}
+
+static size_t map_col_plane_words(int width, int height) {
+    return (size_t)MAP_PLANE_COUNT * (size_t)width * (((size_t)height + 63) / 64);
+}
+
+// 지면 비트맵, 비트 평면, 점유 색인, 타일 배열을 합친 크기 (구조체 뒤에 이 순서로 이어서 할당됨)
+static size_t map_grid_bytes(int width, int height) {
+    return (map_footing_words(width, height) + map_row_plane_words(width, height) +
+            map_col_plane_words(width, height)) * sizeof(uint64_t) +
+           (size_t)width * (size_t)height * (sizeof(MapCell) + 1);
+}
+
+// 평면별 타일 성질 마스크 (하나라도 있으면 비트 1)
+static const uint16_t plane_masks[MAP_PLANE_COUNT] = {
+    [MAP_PLANE_AIR]            = TILE_FLAG_AIR,
+    [MAP_PLANE_SOLID]          = TILE_FLAG_SOLID,
+    [MAP_PLANE_FLOOR]          = TILE_FLAG_SOLID_WHEN_GROUNDED,
+    [MAP_PLANE_PUSHABLE]       = TILE_FLAG_PUSHABLE,
+    [MAP_PLANE_LANDABLE_FIRE]  = TILE_FLAG_LANDABLE | TILE_FLAG_LANDABLE_FIRE,
+    [MAP_PLANE_LANDABLE_WATER] = TILE_FLAG_LANDABLE | TILE_FLAG_LANDABLE_WATER,
+    [MAP_PLANE_DEADLY_FIRE]    = TILE_FLAG_DEADLY_TO_FIRE,
+    [MAP_PLANE_DEADLY_WATER]   = TILE_FLAG_DEADLY_TO_WATER
+};
+
+// 평면 p의 y행 / x열 워드 배열
+static inline const uint64_t* map_row_plane(const Map* map, int p, int y) {
+    return map->row_planes + ((size_t)p * (size_t)map->height + (size_t)y) * (size_t)map->row_words;
+}
+
+static inline const uint64_t* map_col_plane(const Map* map, int p, int x) {
+    return map->col_planes + ((size_t)p * (size_t)map->width + (size_t)x) * (size_t)map->col_words;
+}
+
+// 타일 등록표에서 만든 성질 표
+const uint16_t tile_flags[256] = {
+#define TILE_FLAGS_ENTRY(name, ch, flags) [(uint8_t)(ch)] = (flags),
+    TILE_REGISTRY(TILE_FLAGS_ENTRY)
+#undef TILE_FLAGS_ENTRY
+};
+
+// 그룹 ID를 그룹 인덱스로 인턴 (name이 NULL이면 이름 없는 새 그룹)
+// 스위치마다 최대 한 그룹이므로 그룹 수는 MAX_SWITCHES를 넘지 않음
+static int map_intern_group(Map* map, const char* name) {
+    if (name) {
+        for (int g = 0; g < map->group_count; g++) {
+            if (strcmp(map->groups[g].name, name) == 0) return g;
+        }
+    }
+    if (map->group_count >= MAX_SWITCHES) return -1;
+    
+    int g = map->group_count++;
+    strncpy(map->groups[g].name, name ? name : "", sizeof(map->groups[g].name) - 1);
+    map->groups[g].name[sizeof(map->groups[g].name) - 1] = '\0';
+    map->groups[g].active_count = 0;
+    map->groups[g].boxed_count = 0;
+    return g;
+}
+
+// 신호 이름 -> 신호 비트 (그룹 이름을 먼저 찾고, 없으면 게이트 이름, 둘 다 없으면 -1)
+static int map_find_signal(const Map* map, const LogicGateDef* gates, int gate_count, const char* name) {
+    for (int g = 0; g < map->group_count; g++) {
+        if (map->groups[g].name[0] != '\0' && strcmp(map->groups[g].name, name) == 0) return g;
+    }
+    for (int k = 0; k < gate_count; k++) {
+        if (strcmp(gates[k].name, name) == 0) return map->group_count + k;
+    }
+    return -1;
+}
+
+// 바뀐 신호를 구독자에게 전달 (평면 0 -> 토글 발판, 평면 1 -> 수직 벽)
+// 바뀐 신호 비트와 그 신호의 구독자 비트만 ctz로 훑으므로 작업량은 바뀐 것에 비례
+static void map_publish_signals(Map* map, const uint64_t old_bits[LOGIC_PLANE_COUNT]) {
+    uint64_t changed_active = old_bits[0] ^ map->signal_bits[0];
+    uint64_t changed_boxed = old_bits[1] ^ map->signal_bits[1];
+    for (; changed_active; changed_active &= changed_active - 1) {
+        int signal = __builtin_ctzll(changed_active);
+        bool down = (map->signal_bits[0] >> signal) & 1;
+        for (uint32_t subs = map->toggle_subscribers[signal]; subs; subs &= subs - 1) {
+            map->toggle_platforms[__builtin_ctz(subs)].target_is_down = down;
+        }
+    }
+    for (; changed_boxed; changed_boxed &= changed_boxed - 1) {
+        int signal = __builtin_ctzll(changed_boxed);
+        bool hidden = (map->signal_bits[1] >> signal) & 1;
+        uint32_t subs = map->wall_subscribers[signal];
+        map->moving_walls |= subs; // 다음 map_update_vertical_walls에서 여닫기 시작
+        for (; subs; subs &= subs - 1) {
+            map->vertical_walls[__builtin_ctz(subs)].hidden = hidden;
+        }
+    }
+}
+
+// (x, y) 바로 위의 상자 깨우기 (발밑이 바뀌면 다시 낙하를 검사해야 함)
+static void map_wake_box_above(Map* map, int x, int y) {
+    if ((unsigned)x >= (unsigned)map->width || y <= 0 || y > map->height) return;
+    int box = CELL_AT(map, x, y - 1).box - 1;
+    if (box >= 0) map->awake_boxes |= 1ULL << box;
+}
+
+// 수직 벽을 목표 상태(hidden이면 열림) 쪽으로 진행
+// 열릴 때는 맨 위 줄부터 사라지고 닫힐 때는 아래쪽부터 다시 생김 (벽이 바닥으로 들어갔다 나오는 모양)
+// step_ticks가 0이거나 instant면 한 번에, 아니면 step_ticks 틱마다 한 줄씩
+static void map_step_vertical_wall(Map* map, int i, bool instant) {
+    int wall_x = map->vertical_walls[i].x;
+    int orig_y = map->vertical_walls[i].original_y;
+    int target_y = map->vertical_walls[i].target_y;
+    int top_y = (orig_y < target_y) ? orig_y : target_y;
+    int rows = abs(orig_y - target_y) + 1;
+    int goal = map->vertical_walls[i].hidden ? rows : 0;
+    bool animated = !instant && map->vertical_walls[i].step_ticks > 0;
+    
+    while (map->vertical_walls[i].open_rows != goal) {
+        if (animated && map->vertical_walls[i].step_timer > 0) {
+            map->vertical_walls[i].step_timer--;
+            return;
+        }
+        
+        if (map->vertical_walls[i].open_rows < goal) {
+            map_set_tile(map, wall_x, top_y + map->vertical_walls[i].open_rows, TILE_EMPTY);
+            map->vertical_walls[i].open_rows++;
+        } else {
+            int row_y = top_y + map->vertical_walls[i].open_rows - 1;
+            // 그 칸에 상자가 들어와 있으면 덮어쓰지 않고 빠질 때까지 기다림
+            if (map_find_box(map, wall_x, row_y) >= 0) return;
+            map_set_tile(map, wall_x, row_y, TILE_VERTICAL_WALL);
+            map->vertical_walls[i].open_rows--;
+        }
+        
+        if (animated) {
+            map->vertical_walls[i].step_timer = map->vertical_walls[i].step_ticks - 1;
+            break;
+        }
+    }
+    
+    if (map->vertical_walls[i].open_rows == goal) {
+        map->vertical_walls[i].step_timer = 0;
+        map->moving_walls &= ~(1u << i);
+    }
+}
+
+// (x, y) 타일의 평면 비트를 행 우선/열 우선 양쪽에 다시 기록
+static void map_refresh_planes(Map* map, int x, int y) {
+    uint16_t flags = tile_flags[TILE_AT(map, x, y)];
+    uint64_t* row = map->row_planes + (size_t)y * (size_t)map->row_words + (size_t)(x >> 6);
+    uint64_t* col = map->col_planes + (size_t)x * (size_t)map->col_words + (size_t)(y >> 6);
+    size_t row_stride = (size_t)map->height * (size_t)map->row_words;
+    size_t col_stride = (size_t)map->width * (size_t)map->col_words;
+    uint64_t row_bit = 1ULL << (x & 63);
+    uint64_t col_bit = 1ULL << (y & 63);
+    for (int p = 0; p < MAP_PLANE_COUNT; p++) {
+        if (flags & plane_masks[p]) {
+            row[p * row_stride] |= row_bit;
+            col[p * col_stride] |= col_bit;
+        } else {
+            row[p * row_stride] &= ~row_bit;
+            col[p * col_stride] &= ~col_bit;
+        }
+    }
+}
+
+// (x, y)에 선 캐릭터의 지면 비트 다시 계산
+// 맵 맨 아래, 발밑이 공백이 아닌 타일, 바닥 타일 안, 발밑의 발판이면 지면
+static void map_refresh_footing(Map* map, int x, int y) {
+    if ((unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height) return;
+    bool grounded = y + 1 >= map->height ||
+                    !(tile_flags[TILE_AT(map, x, y + 1)] & TILE_FLAG_AIR) ||
+                    TILE_AT(map, x, y) == TILE_FLOOR ||
+                    CELL_AT(map, x, y + 1).platforms > 0;
+    size_t i = (size_t)y * (size_t)map->width + (size_t)x;
+    if (grounded) {
+        map->footing[i >> 6] |= 1ULL << (i & 63);
+    } else {
+        map->footing[i >> 6] &= ~(1ULL << (i & 63));
+    }
+}
+
+// 가로로 width칸인 발판을 (x, y) 칸에 더하거나(delta = 1) 빼고(delta = -1) 바로 위 칸의 지면 비트 갱신
+static void map_add_platform_cells(Map* map, int x, int width, int y, int delta) {
+    if ((unsigned)y >= (unsigned)map->height) return;
+    for (int w = 0; w < width; w++) {
+        if ((unsigned)(x + w) >= (unsigned)map->width) continue;
+        CELL_AT(map, x + w, y).platforms = (uint8_t)(CELL_AT(map, x + w, y).platforms + delta);
+        map_refresh_footing(map, x + w, y - 1);
+    }
+}
+
+// (x, y)의 스위치를 다시 계산할 목록에 추가
+static void map_mark_switch_dirty(Map* map, int x, int y) {
+    if ((unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height) return;
+    int sw = CELL_AT(map, x, y).sw - 1;
+    if (sw < 0 || map->switches[sw].dirty) return;
+    map->switches[sw].dirty = true;
+    map->dirty_switches[map->dirty_switch_count++] = (uint8_t)sw;
+}
+
 // 맵 생성
+// 구조체, 점유 색인, 타일 배열을 한 번에 할당 (구조체 바로 뒤에 차례로 이어짐)
 Map* map_create(int width, int height) {
-    Map* map = (Map*)malloc(sizeof(Map));
+    if (width <= 0 || height <= 0) return NULL;
+    Map* map = (Map*)malloc(sizeof(Map) + map_grid_bytes(width, height));
     if (!map) return NULL;
     
     map->width = width;
@@ -17,12 +243,15 @@ Map* map_create(int width, int height) {
     map->exit_x = 0;
     map->exit_y = 0;
     map->box_count = 0;
+    map->awake_boxes = 0;
     for (int i = 0; i < MAX_BOXES; i++) {
         map->boxes[i].x = 0;
         map->boxes[i].y = 0;
         map->boxes[i].vy = 0.0f;  // 초기 속도 0
+        map->boxes[i].vy_accumulator = 0.0f;
         map->boxes[i].active = false;
     }
+    map->snapshot = NULL;
     
     // 스위치/도어 초기화
     map->switch_count = 0;
@@ -31,7 +260,22 @@ Map* map_create(int width, int height) {
         map->switches[i].y = 0;
         map->switches[i].activated = false;
         map->switches[i].is_box_switch = false;  // 기본값은 플레이어 스위치
-        map->switches[i].group_id[0] = '\0';  // 빈 그룹 ID
+        map->switches[i].boxed = false;
+        map->switches[i].dirty = false;
+        map->switches[i].group = -1;  // 그룹은 로드 끝에 배정
+    }
+    map->dirty_switch_count = 0;
+    map->group_count = 0;
+    memset(&map->logic, 0, sizeof(map->logic));
+    map->signal_bits[0] = 0;
+    map->signal_bits[1] = 0;
+    memset(map->toggle_subscribers, 0, sizeof(map->toggle_subscribers));
+    memset(map->wall_subscribers, 0, sizeof(map->wall_subscribers));
+    map->vertical_wall_count = 0;
+    map->moving_walls = 0;
+    for (int p = 0; p < 2; p++) {
+        map->switch_player_x[p] = -1;
+        map->switch_player_y[p] = -1;
     }
     
     // 이동 발판 초기화
@@ -39,6 +283,8 @@ Map* map_create(int width, int height) {
     for (int i = 0; i < MAX_PLATFORMS; i++) {
         map->platforms[i].x = 0.0f;
         map->platforms[i].y = 0.0f;
+        map->platforms[i].prev_x = 0.0f;
+        map->platforms[i].prev_y = 0.0f;
         map->platforms[i].vx = 0.0f;
         map->platforms[i].vy = 0.0f;
         map->platforms[i].min_x = 0;
@@ -49,29 +295,22 @@ Map* map_create(int width, int height) {
         map->platforms[i].active = false;
     }
     
-    // 2D 배열 할당
-    map->tiles = (TileType**)malloc(height * sizeof(TileType*));
-    if (!map->tiles) {
-        free(map);
-        return NULL;
-    }
-    
-    for (int i = 0; i < height; i++) {
-        map->tiles[i] = (TileType*)malloc(width * sizeof(TileType));
-        if (!map->tiles[i]) {
-            // 메모리 할당 실패 시 정리
-            for (int j = 0; j < i; j++) {
-                free(map->tiles[j]);
-            }
-            free(map->tiles);
-            free(map);
-            return NULL;
-        }
-        // 빈 공간으로 초기화
-        for (int j = 0; j < width; j++) {
-            map->tiles[i][j] = TILE_EMPTY;
-        }
-    }
+    // 지면 비트맵/점유 색인: 비어 있음 / 비트 평면: 전부 빈 공간 (맵 밖 여백 포함) / 타일 배열: 빈 공간으로 초기화
+    size_t row_plane_words = map_row_plane_words(width, height);
+    size_t col_plane_words = map_col_plane_words(width, height);
+    map->row_words = (width + 63) / 64;
+    map->col_words = (height + 63) / 64;
+    map->footing = (uint64_t*)(map + 1);
+    map->row_planes = map->footing + map_footing_words(width, height);
+    map->col_planes = map->row_planes + row_plane_words;
+    map->cells = (MapCell*)(map->col_planes + col_plane_words);
+    map->tiles = (uint8_t*)(map->cells + (size_t)width * (size_t)height);
+    memset(map->footing, 0, map_footing_words(width, height) * sizeof(uint64_t));
+    memset(map->row_planes, 0, (row_plane_words + col_plane_words) * sizeof(uint64_t));
+    memset(map->row_planes, 0xFF, row_plane_words / MAP_PLANE_COUNT * sizeof(uint64_t)); // 빈 공간은 첫 평면
+    memset(map->col_planes, 0xFF, col_plane_words / MAP_PLANE_COUNT * sizeof(uint64_t));
+    memset(map->cells, 0, (size_t)width * (size_t)height * sizeof(MapCell));
+    memset(map->tiles, TILE_EMPTY, (size_t)width * (size_t)height);
     
     return map;
 }
@@ -80,20 +319,32 @@ Map* map_create(int width, int height) {
 void map_destroy(Map* map) {
     if (!map) return;
     
-    if (map->tiles) {
-        for (int i = 0; i < map->height; i++) {
-            free(map->tiles[i]);
-        }
-        free(map->tiles);
-    }
+    free(map->snapshot);
     free(map);
 }
 
+// 로더 진단 메시지 출력 (suppressed가 있으면 출력하지 않고 표시만 남김)
+static void map_report(bool* suppressed, const char* format, ...) {
+    if (suppressed) {
+        *suppressed = true;
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
 // 맵 파일에서 로드
 Map* map_load_from_file(const char* filename) {
+    return map_load_from_file_quiet(filename, NULL);
+}
+
+// 맵 파일에서 로드 (suppressed가 NULL이 아니면 진단 메시지를 출력하지 않음)
+Map* map_load_from_file_quiet(const char* filename, bool* suppressed) {
     FILE* file = fopen(filename, "r");
     if (!file) {
-        printf("맵 파일을 열 수 없습니다: %s\n", filename);
+        map_report(suppressed, "맵 파일을 열 수 없습니다: %s\n", filename);
         return NULL;
     }
     
@@ -101,8 +352,11 @@ Map* map_load_from_file(const char* filename) {
     int width = 0;
     int height = 0;
     
-    // 먼저 맵 크기 계산
+    // 먼저 맵 크기 계산 (# GROUPS 줄부터는 맵이 아니라 그룹/게이트 정의)
     while (fgets(line, sizeof(line), file)) {
+        if (strncmp(line, "# GROUPS", 8) == 0) {
+            break;
+        }
         int len = strlen(line);
         // 개행 문자 제거
         if (len > 0 && line[len - 1] == '\n') {
@@ -118,7 +372,7 @@ Map* map_load_from_file(const char* filename) {
     
     if (width == 0 || height == 0) {
         fclose(file);
-        printf("맵 파일이 비어있습니다: %s\n", filename);
+        map_report(suppressed, "맵 파일이 비어있습니다: %s\n", filename);
         return NULL;
     }
     
@@ -136,6 +390,7 @@ Map* map_load_from_file(const char* filename) {
     map->platform_count = 0;
     map->toggle_platform_count = 0;
     map->vertical_wall_count = 0;
+    map->moving_walls = 0;
     
     // 파일 다시 읽기
     rewind(file);
@@ -153,7 +408,7 @@ Map* map_load_from_file(const char* filename) {
             if (x < len) {
                 char ch = line[x];
                 TileType tile = (TileType)ch;
-                map->tiles[y][x] = tile;
+                TILE_AT(map, x, y) = tile;
                 
                 // 특수 타일 위치 저장 / 오브젝트 정보 기록
                 if (ch == TILE_FIREBOY_START) {
@@ -172,7 +427,10 @@ Map* map_load_from_file(const char* filename) {
                         map->boxes[idx].x = x;
                         map->boxes[idx].y = y;
                         map->boxes[idx].vy = 0.0f;  // 초기 속도 0
+                        map->boxes[idx].vy_accumulator = 0.0f;
                         map->boxes[idx].active = true;
+                        map->awake_boxes |= 1ULL << idx; // 처음에는 모두 깨어 있음
+                        CELL_AT(map, x, y).box = (uint8_t)(idx + 1);
                     }
                 } else if (ch == TILE_FIRE_GEM || ch == TILE_WATER_GEM) {
                     // 보석 위치 기록하고 타일은 EMPTY로 변경
@@ -182,9 +440,10 @@ Map* map_load_from_file(const char* filename) {
                         map->gems[idx].y = y;
                         map->gems[idx].type = tile;
                         map->gems[idx].collected = false;
+                        CELL_AT(map, x, y).gem = (uint8_t)(idx + 1);
                     }
                     // 타일 레이어에서는 빈 공간으로 처리 (박스가 통과 가능)
-                    map->tiles[y][x] = TILE_EMPTY;
+                    TILE_AT(map, x, y) = TILE_EMPTY;
                 } else if (ch == TILE_SWITCH) {
                     // 플레이어 스위치 위치 기록 (기본 그룹 ID 없음)
                     if (map->switch_count < MAX_SWITCHES) {
@@ -193,7 +452,10 @@ Map* map_load_from_file(const char* filename) {
                         map->switches[idx].y = y;
                         map->switches[idx].activated = false;
                         map->switches[idx].is_box_switch = false;  // 플레이어 스위치
-                        map->switches[idx].group_id[0] = '\0';  // 일단 빈 그룹 ID
+                        map->switches[idx].boxed = false;
+                        map->switches[idx].dirty = false;
+                        map->switches[idx].group = -1;  // 그룹은 로드 끝에 배정
+                        CELL_AT(map, x, y).sw = (uint8_t)(idx + 1);
                     }
                 } else if (ch == TILE_BOX_SWITCH) {
                     // 상자 스위치 위치 기록 (기본 그룹 ID 없음)
@@ -203,7 +465,10 @@ Map* map_load_from_file(const char* filename) {
                         map->switches[idx].y = y;
                         map->switches[idx].activated = false;
                         map->switches[idx].is_box_switch = true;  // 상자 스위치
-                        map->switches[idx].group_id[0] = '\0';  // 일단 빈 그룹 ID
+                        map->switches[idx].boxed = false;
+                        map->switches[idx].dirty = false;
+                        map->switches[idx].group = -1;  // 그룹은 로드 끝에 배정
+                        CELL_AT(map, x, y).sw = (uint8_t)(idx + 1);
                     }
                 } else if (ch == TILE_MOVING_PLATFORM) {
                     // 이동 발판 위치 기록 (기본: 위아래 왕복)
@@ -211,6 +476,8 @@ Map* map_load_from_file(const char* filename) {
                         int idx = map->platform_count++;
                         map->platforms[idx].x = (float)x;
                         map->platforms[idx].y = (float)y;
+                        map->platforms[idx].prev_x = (float)x;
+                        map->platforms[idx].prev_y = (float)y;
                         map->platforms[idx].vx = 0.0f;
                         map->platforms[idx].vy = -2.0f; // 위로 이동 시작
                         map->platforms[idx].vertical = true;
@@ -227,13 +494,15 @@ Map* map_load_from_file(const char* filename) {
                         map->platforms[idx].active = true;
                     }
                     // 발판은 오버레이로만 그려지므로 타일은 빈 칸으로 설정
-                    map->tiles[y][x] = TILE_EMPTY;
+                    TILE_AT(map, x, y) = TILE_EMPTY;
                 } else if (ch == TILE_HORIZONTAL_PLATFORM) {
                     // 좌우 이동 발판 위치 기록
                     if (map->platform_count < MAX_PLATFORMS) {
                         int idx = map->platform_count++;
                         map->platforms[idx].x = (float)x;
                         map->platforms[idx].y = (float)y;
+                        map->platforms[idx].prev_x = (float)x;
+                        map->platforms[idx].prev_y = (float)y;
                         map->platforms[idx].vx = 2.0f; // 오른쪽으로 이동 시작
                         map->platforms[idx].vy = 0.0f;
                         map->platforms[idx].vertical = false; // 가로 이동
@@ -250,10 +519,10 @@ Map* map_load_from_file(const char* filename) {
                         map->platforms[idx].active = true;
                     }
                     // 발판은 오버레이로만 그려지므로 타일은 빈 칸으로 설정
-                    map->tiles[y][x] = TILE_EMPTY;
+                    TILE_AT(map, x, y) = TILE_EMPTY;
                 }
             } else {
-                map->tiles[y][x] = TILE_EMPTY;
+                TILE_AT(map, x, y) = TILE_EMPTY;
             }
         }
         y++;
@@ -266,10 +535,10 @@ Map* map_load_from_file(const char* filename) {
     for (int py = 0; py < height; py++) {
         for (int px = 0; px < width; px++) {
             // 토글 플랫폼 'T' 처리
-            if (map->tiles[py][px] == 'T') {
+            if (TILE_AT(map, px, py) == 'T') {
                 // 연속된 'T'들을 하나의 플랫폼으로 처리
                 int platform_width = 1;
-                while (px + platform_width < width && map->tiles[py][px + platform_width] == 'T') {
+                while (px + platform_width < width && TILE_AT(map, px + platform_width, py) == 'T') {
                     platform_width++;
                 }
                 
@@ -278,18 +547,19 @@ Map* map_load_from_file(const char* filename) {
                     map->toggle_platforms[idx].x = px;
                     map->toggle_platforms[idx].width = platform_width;
                     map->toggle_platforms[idx].y = (float)py;
+                    map->toggle_platforms[idx].prev_y = (float)py;
                     map->toggle_platforms[idx].original_y = py;
                     
                     // 아래로 내려가면서 't' (목표 위치) 찾기
                     int target_y = py;
                     for (int search_y = py + 1; search_y < height; search_y++) {
                         // 't' 찾으면 그 위치로 설정
-                        if (map->tiles[search_y][px] == 't') {
+                        if (TILE_AT(map, px, search_y) == 't') {
                             target_y = search_y;
                             break;
                         }
                         // 't' 못 찾고 바닥/벽/물/불이 나오면 그 바로 위까지
-                        TileType below = map->tiles[search_y][px];
+                        TileType below = TILE_AT(map, px, search_y);
                         if (below == TILE_FLOOR || below == TILE_WALL || 
                             below == TILE_WATER_TERRAIN || below == TILE_FIRE_TERRAIN) {
                             target_y = search_y - 1;
@@ -313,27 +583,19 @@ Map* map_load_from_file(const char* filename) {
                             closest_switch = si;
                         }
                     }
-                    map->toggle_platforms[idx].linked_switch = closest_switch;
-                    
-                    // 가장 가까운 스위치의 그룹 ID를 구독
-                    if (closest_switch >= 0 && map->switches[closest_switch].group_id[0] != '\0') {
-                        strncpy(map->toggle_platforms[idx].linked_group, 
-                                map->switches[closest_switch].group_id, 31);
-                        map->toggle_platforms[idx].linked_group[31] = '\0';
-                    } else {
-                        map->toggle_platforms[idx].linked_group[0] = '\0';
-                    }
+                    map->toggle_platforms[idx].linked_switch = closest_switch; // 이 스위치의 그룹을 구독 (로드 끝에 배정)
+                    map->toggle_platforms[idx].signal = -1;
                     
                     // 'T' 타일들을 EMPTY로 변경 (오버레이로만 렌더링)
                     for (int w = 0; w < platform_width; w++) {
-                        map->tiles[py][px + w] = TILE_EMPTY;
+                        TILE_AT(map, px + w, py) = TILE_EMPTY;
                     }
                 }
                 
                 px += platform_width - 1; // 이미 처리한 'T'들 건너뛰기
             }
             // 수직 벽 'V' 처리
-            else if (map->tiles[py][px] == 'V') {
+            else if (TILE_AT(map, px, py) == 'V') {
                 if (map->vertical_wall_count < MAX_PLATFORMS) {
                     int idx = map->vertical_wall_count++;
                     map->vertical_walls[idx].x = px;
@@ -343,14 +605,17 @@ Map* map_load_from_file(const char* filename) {
                     // 같은 x 열에서 'v' 찾기 (타겟 위치)
                     int target_y = py;
                     for (int search_y = py - 1; search_y >= 0; search_y--) {
-                        if (map->tiles[search_y][px] == 'v') {
+                        if (TILE_AT(map, px, search_y) == 'v') {
                             target_y = search_y;
                             break;
                         }
                     }
                     
                     map->vertical_walls[idx].target_y = target_y;
-                    map->vertical_walls[idx].is_up = false;
+                    map->vertical_walls[idx].hidden = false;
+                    map->vertical_walls[idx].open_rows = 0;  // 닫힌 상태로 시작
+                    map->vertical_walls[idx].step_ticks = 0;
+                    map->vertical_walls[idx].step_timer = 0;
                     
                     // 가장 가까운 스위치 찾기
                     int closest_switch = -1;
@@ -364,29 +629,41 @@ Map* map_load_from_file(const char* filename) {
                             closest_switch = si;
                         }
                     }
-                    map->vertical_walls[idx].linked_switch = closest_switch;
+                    map->vertical_walls[idx].linked_switch = closest_switch; // 이 스위치의 그룹을 구독 (로드 끝에 배정)
+                    map->vertical_walls[idx].signal = -1;
                     
-                    // 가장 가까운 스위치의 그룹 ID를 구독
-                    if (closest_switch >= 0 && map->switches[closest_switch].group_id[0] != '\0') {
-                        strncpy(map->vertical_walls[idx].linked_group, 
-                                map->switches[closest_switch].group_id, 31);
-                        map->vertical_walls[idx].linked_group[31] = '\0';
-                    } else {
-                        map->vertical_walls[idx].linked_group[0] = '\0';
+                    // 벽은 닫힌 상태로 시작 ('v'까지 이어진 범위 전체를 V 타일로)
+                    int min_y = (py < target_y) ? py : target_y;
+                    int max_y = (py > target_y) ? py : target_y;
+                    for (int wy = min_y; wy <= max_y; wy++) {
+                        TILE_AT(map, px, wy) = TILE_VERTICAL_WALL;
                     }
-                    
-                    // 'V' 타일을 EMPTY로 변경
-                    map->tiles[py][px] = TILE_EMPTY;
                 }
             }
-            // 't'와 'v'도 EMPTY로 변경
-            else if (map->tiles[py][px] == 't' || map->tiles[py][px] == 'v') {
-                map->tiles[py][px] = TILE_EMPTY;
-            }
+        }
+    }
+    
+    // 남은 't'와 'v'를 EMPTY로 변경
+    // (같은 훑기에서 지우면 'v'가 아래쪽 'V'보다 먼저 지워져 벽이 목표 위치를 찾지 못함)
+    for (int i = 0; i < width * height; i++) {
+        if (map->tiles[i] == 't' || map->tiles[i] == 'v') {
+            map->tiles[i] = TILE_EMPTY;
         }
     }
     
     // 파일을 다시 열어서 그룹 ID 섹션 파싱 (# GROUPS)
+    // 게이트 정의와 T/V 연결 줄은 모든 이름이 나온 뒤에 신호 비트로 바꿈
+    LogicGateDef gate_defs[MAX_LOGIC_GATES];
+    int gate_def_count = 0;
+    struct {
+        char type;
+        int x;
+        int y;
+        char name[32];
+        int step_ticks;
+    } links[MAX_PLATFORMS * 2];
+    int link_count = 0;
+    
     file = fopen(filename, "r");
     if (file) {
         bool in_groups_section = false;
@@ -404,64 +681,287 @@ Map* map_load_from_file(const char* filename) {
             }
             
             if (in_groups_section && line[0] != '\0' && line[0] != '#') {
+                // 논리 게이트: AND|OR|XOR|NOT 이름 입력... / LATCH 이름 틱수 입력... / COUNTER 이름 횟수 입력...
+                if (gate_def_count < MAX_LOGIC_GATES && logic_parse_gate(line, &gate_defs[gate_def_count])) {
+                    gate_def_count++;
+                    continue;
+                }
+                
                 // 형식: S x y group_id 또는 X x y group_id (상자 스위치)
+                //       T x y 신호 (토글 발판 연결) 또는 V x y 신호 [틱] (수직 벽 연결, 틱마다 한 줄씩 여닫음)
                 char type;
                 int sx, sy;
                 char group_id[32];
-                if (sscanf(line, "%c %d %d %31s", &type, &sx, &sy, group_id) == 4) {
+                int step_ticks = 0;
+                if (sscanf(line, "%c %d %d %31s %d", &type, &sx, &sy, group_id, &step_ticks) >= 4) {
                     if (type == 'S' || type == 'X') {
-                        // 해당 위치의 스위치 찾기
-                        for (int i = 0; i < map->switch_count; i++) {
-                            if (map->switches[i].x == sx && map->switches[i].y == sy) {
-                                strncpy(map->switches[i].group_id, group_id, 31);
-                                map->switches[i].group_id[31] = '\0';
-                                break;
-                            }
+                        // 해당 위치의 스위치를 그룹에 넣기
+                        int i = map_find_switch(map, sx, sy);
+                        if (i >= 0) {
+                            map->switches[i].group = map_intern_group(map, group_id);
                         }
+                    } else if ((type == 'T' || type == 'V') && link_count < MAX_PLATFORMS * 2) {
+                        links[link_count].type = type;
+                        links[link_count].x = sx;
+                        links[link_count].y = sy;
+                        strcpy(links[link_count].name, group_id);
+                        links[link_count].step_ticks = step_ticks > 0 ? step_ticks : 0;
+                        link_count++;
                     }
                 }
             }
         }
         fclose(file);
-        
-        // 그룹 ID가 설정된 스위치들의 그룹을 발판/벽에 할당
-        for (int i = 0; i < map->toggle_platform_count; i++) {
-            int closest_switch = map->toggle_platforms[i].linked_switch;
-            if (closest_switch >= 0 && map->switches[closest_switch].group_id[0] != '\0') {
-                strncpy(map->toggle_platforms[i].linked_group, 
-                        map->switches[closest_switch].group_id, 31);
-                map->toggle_platforms[i].linked_group[31] = '\0';
+    }
+    
+    // 그룹 ID가 없는 스위치는 혼자 한 그룹
+    for (int i = 0; i < map->switch_count; i++) {
+        if (map->switches[i].group < 0) {
+            map->switches[i].group = map_intern_group(map, NULL);
+        }
+    }
+    
+    // 게이트 입력/출력을 신호 비트로 바꾼 뒤 위상 순서로 컴파일
+    // 찾을 수 없는 입력이 하나라도 있으면 게이트를 버림 (입력 마스크 0 -> 컴파일되지 않고 출력은 꺼진 채로 남음)
+    for (int k = 0; k < gate_def_count; k++) {
+        gate_defs[k].output = map->group_count + k;
+        gate_defs[k].inputs = 0;
+        for (int n = 0; n < gate_defs[k].input_count; n++) {
+            int signal = map_find_signal(map, gate_defs, gate_def_count, gate_defs[k].input_names[n]);
+            if (signal < 0) {
+                map_report(suppressed, "게이트 %s의 입력 신호를 찾을 수 없습니다: %s (%s)\n",
+                           gate_defs[k].name, gate_defs[k].input_names[n], filename);
+                gate_defs[k].inputs = 0;
+                break;
             }
+            gate_defs[k].inputs |= 1ULL << signal;
         }
-        
-        for (int i = 0; i < map->vertical_wall_count; i++) {
-            int closest_switch = map->vertical_walls[i].linked_switch;
-            if (closest_switch >= 0 && map->switches[closest_switch].group_id[0] != '\0') {
-                strncpy(map->vertical_walls[i].linked_group, 
-                        map->switches[closest_switch].group_id, 31);
-                map->vertical_walls[i].linked_group[31] = '\0';
+    }
+    logic_compile(&map->logic, gate_defs, gate_def_count);
+    
+    // 발판/벽은 가장 가까운 스위치의 그룹을 구독 (T/V 줄이 있으면 그 신호를 구독)
+    for (int i = 0; i < map->toggle_platform_count; i++) {
+        int closest_switch = map->toggle_platforms[i].linked_switch;
+        if (closest_switch >= 0) {
+            map->toggle_platforms[i].signal = map->switches[closest_switch].group;
+        }
+    }
+    for (int i = 0; i < map->vertical_wall_count; i++) {
+        int closest_switch = map->vertical_walls[i].linked_switch;
+        if (closest_switch >= 0) {
+            map->vertical_walls[i].signal = map->switches[closest_switch].group;
+        }
+    }
+    for (int l = 0; l < link_count; l++) {
+        int signal = map_find_signal(map, gate_defs, gate_def_count, links[l].name);
+        if (signal < 0) continue;
+        if (links[l].type == 'T') {
+            // 토글 발판은 가로로 이어진 칸 중 어디를 적어도 됨
+            for (int i = 0; i < map->toggle_platform_count; i++) {
+                if (map->toggle_platforms[i].original_y == links[l].y &&
+                    links[l].x >= map->toggle_platforms[i].x &&
+                    links[l].x < map->toggle_platforms[i].x + map->toggle_platforms[i].width) {
+                    map->toggle_platforms[i].signal = signal;
+                }
             }
+        } else {
+            for (int i = 0; i < map->vertical_wall_count; i++) {
+                if (map->vertical_walls[i].x == links[l].x && map->vertical_walls[i].original_y == links[l].y) {
+                    map->vertical_walls[i].signal = signal;
+                    map->vertical_walls[i].step_ticks = links[l].step_ticks;
+                }
+            }
+        }
+    }
+    
+    // 신호별 구독자 집합 (이후 신호가 바뀌면 이 비트만 훑음)
+    for (int i = 0; i < map->toggle_platform_count; i++) {
+        int signal = map->toggle_platforms[i].signal;
+        if (signal >= 0 && signal < LOGIC_MAX_SIGNALS) map->toggle_subscribers[signal] |= 1u << i;
+    }
+    for (int i = 0; i < map->vertical_wall_count; i++) {
+        int signal = map->vertical_walls[i].signal;
+        if (signal >= 0 && signal < LOGIC_MAX_SIGNALS) map->wall_subscribers[signal] |= 1u << i;
+    }
+    
+    // 스위치가 모두 꺼진 초기 상태로 네트워크를 한 번 평가 (NOT 게이트 등은 처음부터 켜져 있음)
+    logic_evaluate(&map->logic, map->signal_bits);
+    uint64_t all_changed[LOGIC_PLANE_COUNT] = { ~map->signal_bits[0], ~map->signal_bits[1] };
+    map_publish_signals(map, all_changed);
+    
+    // 처음부터 열려 있어야 하는 벽은 애니메이션 없이 바로 열기
+    for (int i = 0; i < map->vertical_wall_count; i++) {
+        if ((map->moving_walls >> i) & 1) {
+            map_step_vertical_wall(map, i, true);
+        }
+    }
+    
+    // 발판이 덮은 칸을 기록하고 지면 비트맵과 비트 평면 전체 계산 (이후로는 바뀐 칸만 갱신)
+    for (int i = 0; i < map->platform_count; i++) {
+        if (!map->platforms[i].active) continue;
+        map_add_platform_cells(map, (int)roundf(map->platforms[i].x), 1, (int)roundf(map->platforms[i].y), 1);
+    }
+    for (int i = 0; i < map->toggle_platform_count; i++) {
+        map_add_platform_cells(map, map->toggle_platforms[i].x, map->toggle_platforms[i].width,
+                               (int)roundf(map->toggle_platforms[i].y), 1);
+    }
+    for (int fy = 0; fy < height; fy++) {
+        for (int fx = 0; fx < width; fx++) {
+            map_refresh_footing(map, fx, fy);
+            map_refresh_planes(map, fx, fy);
         }
     }
     
+    // 리스폰용 원본 저장 (실패하면 map_reset이 false를 반환하고 호출자가 다시 로드)
+    map_save_snapshot(map);
+    
     return map;
 }
 
-// 해당 위치가 이동 가능한지 확인
-// 타일 가져오기
-TileType map_get_tile(const Map* map, int x, int y) {
-    if (!map || x < 0 || x >= map->width || y < 0 || y >= map->height) {
-        return TILE_EMPTY;
-    }
-    return map->tiles[y][x];
+// 현재 상태를 원본 스냅샷으로 저장
+bool map_save_snapshot(Map* map) {
+    if (!map) return false;
+    
+    size_t grid_bytes = map_grid_bytes(map->width, map->height);
+    struct MapSnapshot* snapshot = (struct MapSnapshot*)realloc(map->snapshot,
+        sizeof(struct MapSnapshot) + grid_bytes);
+    if (!snapshot) return false;
+    
+    map->snapshot = snapshot;
+    memcpy(&snapshot->state, map, sizeof(Map));
+    memcpy(snapshot->grid, map->footing, grid_bytes); // 지면 비트맵, 비트 평면, 점유 색인, 타일 배열은 연속된 메모리
+    return true;
 }
 
+// 스냅샷으로 복원 (기존 할당을 그대로 쓰므로 메모리 할당/파일 입출력 없음)
+bool map_reset(Map* map) {
+    if (!map || !map->snapshot) return false;
+    
+    struct MapSnapshot* snapshot = map->snapshot;
+    uint64_t* footing = map->footing;
+    uint64_t* row_planes = map->row_planes;
+    uint64_t* col_planes = map->col_planes;
+    MapCell* cells = map->cells;
+    uint8_t* tiles = map->tiles;
+    
+    memcpy(map, &snapshot->state, sizeof(Map));
+    map->footing = footing;
+    map->row_planes = row_planes;
+    map->col_planes = col_planes;
+    map->cells = cells;
+    map->tiles = tiles;
+    map->snapshot = snapshot;
+    memcpy(footing, snapshot->grid, map_grid_bytes(map->width, map->height));
+    return true;
+}
+
+// 해당 위치가 이동 가능한지 확인
 // 타일 설정
 void map_set_tile(Map* map, int x, int y, TileType tile) {
     if (!map || x < 0 || x >= map->width || y < 0 || y >= map->height) {
         return;
     }
-    map->tiles[y][x] = tile;
+    // 상자를 받치던 타일이 사라지거나 새로 생기면 그 위 상자를 깨움
+    uint16_t changed = tile_flags[TILE_AT(map, x, y)] ^ tile_get_flags(tile);
+    TILE_AT(map, x, y) = (uint8_t)tile;
+    if (changed & (TILE_FLAG_BOX_SUPPORT | TILE_FLAG_BOX_PASSABLE)) {
+        map_wake_box_above(map, x, y);
+    }
+    if (changed) {
+        map_refresh_planes(map, x, y);
+    }
+    
+    // 이 칸과 바로 위 칸에 선 캐릭터의 지면 여부가 바뀔 수 있음
+    map_refresh_footing(map, x, y);
+    map_refresh_footing(map, x, y - 1);
+}
+
+// 아래로 지나갈 수 있는 줄 수
+// 열 워드 하나로 64줄씩 "멈춰야 하는 줄" 비트를 만들고 ctz로 첫 줄을 찾음
+// 멈춰야 하는 줄: 공백이 아니면서 벽이거나, (바닥 타일 && 아래 공백)이거나, 아래가 착지 가능하거나, 자신/아래가 위험 지형
+int map_fall_run(const Map* map, int player_idx, int x, int y) {
+    if (!map || (unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height) return 0;
+    
+    const uint64_t* air = map_col_plane(map, MAP_PLANE_AIR, x);
+    const uint64_t* solid = map_col_plane(map, MAP_PLANE_SOLID, x);
+    const uint64_t* floor_tiles = map_col_plane(map, MAP_PLANE_FLOOR, x);
+    const uint64_t* landable = map_col_plane(map, MAP_PLANE_LANDABLE_FIRE + player_idx, x);
+    const uint64_t* deadly = map_col_plane(map, MAP_PLANE_DEADLY_FIRE + player_idx, x);
+    
+    int start = y + 1;
+    for (int k = start >> 6; k < map->col_words; k++) {
+        // 다음 워드의 첫 비트를 끌어와 "한 줄 아래" 비트열을 만듦 (맵 밖은 빈 공간)
+        bool last = k + 1 >= map->col_words;
+        uint64_t below_air = (air[k] >> 1) | ((last ? ~0ULL : air[k + 1]) << 63);
+        uint64_t below_landable = (landable[k] >> 1) | ((last ? 0 : landable[k + 1]) << 63);
+        uint64_t below_deadly = (deadly[k] >> 1) | ((last ? 0 : deadly[k + 1]) << 63);
+        
+        uint64_t stops = ~air[k] & (solid[k] | (floor_tiles[k] & below_air) | below_landable |
+                                    deadly[k] | below_deadly);
+        if (k == start >> 6) stops &= ~0ULL << (start & 63);
+        if (stops) return k * 64 + __builtin_ctzll(stops) - start;
+    }
+    return map->height - start; // 맵 맨 아래까지
+}
+
+// 위로 올라갈 수 있는 줄 수 (벽/바닥 타일 비트를 clz로 아래에서 위로 찾음)
+int map_rise_run(const Map* map, int x, int y) {
+    if (!map || (unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height) return 0;
+    
+    const uint64_t* solid = map_col_plane(map, MAP_PLANE_SOLID, x);
+    const uint64_t* floor_tiles = map_col_plane(map, MAP_PLANE_FLOOR, x);
+    
+    int start = y - 1;
+    if (start < 0) return 0;
+    for (int k = start >> 6; k >= 0; k--) {
+        uint64_t ceilings = solid[k] | floor_tiles[k];
+        if (k == start >> 6) ceilings &= ~0ULL >> (63 - (start & 63));
+        if (ceilings) return start - (k * 64 + 63 - __builtin_clzll(ceilings));
+    }
+    return y; // 맵 맨 위까지
+}
+
+// 옆으로 걸어갈 수 있는 칸 수 (행 워드에서 막히는 칸 비트를 오른쪽은 ctz, 왼쪽은 clz로 찾음)
+int map_walk_run(const Map* map, int player_idx, int x, int y, int dir, bool grounded) {
+    if (!map || (unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height) return 0;
+    
+    const uint64_t* solid = map_row_plane(map, MAP_PLANE_SOLID, y);
+    const uint64_t* pushable = map_row_plane(map, MAP_PLANE_PUSHABLE, y);
+    const uint64_t* floor_tiles = map_row_plane(map, MAP_PLANE_FLOOR, y);
+    const uint64_t* deadly = map_row_plane(map, MAP_PLANE_DEADLY_FIRE + player_idx, y);
+    uint64_t floor_mask = grounded ? ~0ULL : 0;
+    
+    if (dir > 0) {
+        int start = x + 1;
+        for (int k = start >> 6; k < map->row_words; k++) {
+            uint64_t blocks = solid[k] | pushable[k] | deadly[k] | (floor_tiles[k] & floor_mask);
+            if (k == start >> 6) blocks &= ~0ULL << (start & 63);
+            if (blocks) return k * 64 + __builtin_ctzll(blocks) - start;
+        }
+        return map->width - start; // 맵 오른쪽 끝까지
+    }
+    
+    int start = x - 1;
+    if (start < 0) return 0;
+    for (int k = start >> 6; k >= 0; k--) {
+        uint64_t blocks = solid[k] | pushable[k] | deadly[k] | (floor_tiles[k] & floor_mask);
+        if (k == start >> 6) blocks &= ~0ULL >> (63 - (start & 63));
+        if (blocks) return start - (k * 64 + 63 - __builtin_clzll(blocks));
+    }
+    return x; // 맵 왼쪽 끝까지
+}
+
+// 현재 칸과 발밑 칸의 위험 지형 비트 확인 (맵 밖은 빈 공간)
+bool map_touches_hazard(const Map* map, int player_idx, int x, int y) {
+    if (!map || (unsigned)x >= (unsigned)map->width) return false;
+    
+    const uint64_t* deadly = map_col_plane(map, MAP_PLANE_DEADLY_FIRE + player_idx, x);
+    for (int row = y; row <= y + 1; row++) {
+        if ((unsigned)row < (unsigned)map->height && ((deadly[row >> 6] >> (row & 63)) & 1)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 // 상자 관련 헬퍼 구현
@@ -482,13 +982,8 @@ int map_get_box_y(const Map* map, int index) {
 
 // (x, y)에 있는 상자의 인덱스를 찾기 (없으면 -1)
 int map_find_box(const Map* map, int x, int y) {
-    if (!map) return -1;
-    for (int i = 0; i < map->box_count; i++) {
-        if (map->boxes[i].active && map->boxes[i].x == x && map->boxes[i].y == y) {
-            return i;
-        }
-    }
-    return -1;
+    if (!map || (unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height) return -1;
+    return (int)CELL_AT(map, x, y).box - 1;
 }
 
 // 상자를 새 위치로 이동 (타일 배열과 boxes 배열 동기화)
@@ -500,50 +995,30 @@ bool map_move_box(Map* map, int index, int new_x, int new_y) {
     int old_x = map->boxes[index].x;
     int old_y = map->boxes[index].y;
 
-    // 새 위치가 비어 있는지 확인
-    TileType target = map_get_tile(map, new_x, new_y);
-    // 공백이거나 스위치 위로는 이동 가능 (보석은 이제 타일에 없음)
-    if (target != TILE_EMPTY && target != TILE_SWITCH && target != TILE_BOX_SWITCH) {
+    // 새 위치가 상자가 들어갈 수 있는 칸인지 확인 (공백, 스위치)
+    if (!(map_get_tile_flags(map, new_x, new_y) & TILE_FLAG_BOX_PASSABLE)) {
         return false;
     }
 
-    // 이전 위치의 타일 복구 (플레이어가 들어갈 수 있도록)
-    bool was_on_switch = false;
-    bool was_box_switch = false;
-    
-    for (int i = 0; i < map->switch_count; i++) {
-        if (map->switches[i].x == old_x && map->switches[i].y == old_y) {
-            was_on_switch = true;
-            was_box_switch = map->switches[i].is_box_switch;
-            break;
-        }
-    }
-    
-    if (was_on_switch) {
-        // 스위치 위였으면 스위치 타입에 맞게 복구
-        map_set_tile(map, old_x, old_y, was_box_switch ? TILE_BOX_SWITCH : TILE_SWITCH);
+    // 이전 위치의 타일 복구 (스위치 위였으면 스위치 타입에 맞게, 아니면 플레이어가 들어갈 수 있도록 EMPTY)
+    int old_switch = map_find_switch(map, old_x, old_y);
+    if (old_switch >= 0) {
+        map_set_tile(map, old_x, old_y, map->switches[old_switch].is_box_switch ? TILE_BOX_SWITCH : TILE_SWITCH);
     } else {
-        // 그 외의 경우는 EMPTY로 (플레이어가 들어갈 수 있도록)
         map_set_tile(map, old_x, old_y, TILE_EMPTY);
     }
     
-    // 새 위치의 타일 설정
-    bool new_is_on_switch = false;
-    
-    for (int i = 0; i < map->switch_count; i++) {
-        if (map->switches[i].x == new_x && map->switches[i].y == new_y) {
-            new_is_on_switch = true;
-            break;
-        }
-    }
+    // 새 위치의 타일 설정 (스위치 위라도 박스로 덮어쓰되, 스위치 정보는 switches 배열에 있으므로 기능은 유지됨)
+    map_set_tile(map, new_x, new_y, TILE_BOX);
+
+    // 점유 색인 갱신
+    CELL_AT(map, old_x, old_y).box = 0;
+    CELL_AT(map, new_x, new_y).box = (uint8_t)(index + 1);
+    map_mark_switch_dirty(map, old_x, old_y);
+    map_mark_switch_dirty(map, new_x, new_y);
     
-    if (new_is_on_switch) {
-        // 스위치 위면 박스로 덮어쓰되, 스위치 정보는 switches 배열에 있으므로 기능은 유지됨
-        map_set_tile(map, new_x, new_y, TILE_BOX);
-    } else {
-        // 그 외의 경우 박스로 설정
-        map_set_tile(map, new_x, new_y, TILE_BOX);
-    }
+    // 옮겨진 상자는 새 자리에서 다시 낙하 검사
+    map->awake_boxes |= 1ULL << index;
 
     // 상자 좌표 갱신
     map->boxes[index].x = new_x;
@@ -552,6 +1027,17 @@ bool map_move_box(Map* map, int index, int new_x, int new_y) {
     return true;
 }
 
+// 상자가 지면 위에 있는지 확인
+static bool box_is_on_ground(const Map* map, int box_x, int box_y) {
+    if (box_y + 1 >= map->height) {
+        return true; // 맵 밖 = 바닥에 있음
+    }
+    // 벽, 바닥, 스위치(플레이어/상자 모두), 다른 상자는 지면으로 간주
+    // 상자가 들어갈 수 없는 칸(속성/독 지형, 수직 벽, 시작 위치 등)도 더 내려갈 수 없으므로 지면
+    uint16_t below = map_get_tile_flags(map, box_x, box_y + 1);
+    return (below & TILE_FLAG_BOX_SUPPORT) || !(below & TILE_FLAG_BOX_PASSABLE);
+}
+
 // 상자 중력/물리 업데이트 (매 프레임 호출)
 void map_update_boxes(Map* map, float delta_time) {
     if (!map) return;
@@ -560,25 +1046,22 @@ void map_update_boxes(Map* map, float delta_time) {
     const float BOX_GRAVITY = 30.0f;         // 중력 가속도
     const float BOX_MAX_FALL_SPEED = 20.0f;  // 최대 낙하 속도
     
-    // 각 상자에 대해 중력 적용
+    // 깨어 있는 상자만 인덱스 순서대로 중력 적용
+    // (처리 중에 깨어난 뒤쪽 상자는 이번 틱에 바로 처리되도록 매번 남은 비트를 다시 읽음)
     for (int i = 0; i < map->box_count; i++) {
-        if (!map->boxes[i].active) continue;
+        uint64_t pending = map->awake_boxes >> i;
+        if (!pending) break;
+        i += __builtin_ctzll(pending);
+        if (!map->boxes[i].active) {
+            map->awake_boxes &= ~(1ULL << i);
+            continue;
+        }
         
         int box_x = map->boxes[i].x;
         int box_y = map->boxes[i].y;
         
         // 상자 아래 타일 확인 (지상 체크)
-        bool is_on_ground = false;
-        if (box_y + 1 >= map->height) {
-            is_on_ground = true; // 맵 밖 = 바닥에 있음
-        } else {
-            TileType tile_below = map_get_tile(map, box_x, box_y + 1);
-            // 벽, 바닥, 스위치(플레이어/상자 모두), 다른 상자는 지면으로 간주
-            if (tile_below == TILE_WALL || tile_below == TILE_FLOOR ||
-                tile_below == TILE_SWITCH || tile_below == TILE_BOX_SWITCH || tile_below == TILE_BOX) {
-                is_on_ground = true;
-            }
-        }
+        bool is_on_ground = box_is_on_ground(map, box_x, box_y);
         
         // 중력 적용
         if (!is_on_ground) {
@@ -596,63 +1079,42 @@ void map_update_boxes(Map* map, float delta_time) {
         }
         
         // 속도 누적 (플레이어와 동일한 방식)
-        static float vy_accumulator[MAX_BOXES] = {0.0f}; // 각 상자별 속도 누적
+        float* vy_accumulator = &map->boxes[i].vy_accumulator;
         
-        vy_accumulator[i] += map->boxes[i].vy * delta_time;
+        *vy_accumulator += map->boxes[i].vy * delta_time;
         
         // 누적된 속도가 1타일 이상이면 이동
-        while (fabsf(vy_accumulator[i]) >= 1.0f) { {
-            if (vy_accumulator[i] > 0.0f) {
+        while (fabsf(*vy_accumulator) >= 1.0f) { {
+            if (*vy_accumulator > 0.0f) {
                 // 아래로 이동 (낙하)
                 int new_y = box_y + 1;
                 if (new_y >= map->height) {
                     // 맵 밖으로 나가면 멈춤
                     map->boxes[i].vy = 0;
-                    vy_accumulator[i] = 0.0f;
+                    *vy_accumulator = 0.0f;
                     break;
                 }
                 
-                TileType tile_below = map_get_tile(map, box_x, new_y);
-                
-                // 먼저 바로 아래가 벽이나 바닥인지 확인
-                if (tile_below == TILE_WALL || tile_below == TILE_FLOOR) {
-                    // 바로 아래가 바닥이면 현재 위치에서 멈춤 (이미 캐릭터 공간 없음)
-                    map->boxes[i].vy = 0;
-                    vy_accumulator[i] = 0.0f;
-                    break;
+                // 상자가 들어갈 수 있는 칸(공백, 스위치)이면 계속 낙하, 벽/바닥/상자 등은 멈춤
+                if ((map_get_tile_flags(map, box_x, new_y) & TILE_FLAG_BOX_PASSABLE) &&
+                    map_move_box(map, i, box_x, new_y)) {
+                    box_y = new_y; // 위치 업데이트
+                    *vy_accumulator -= 1.0f;
+                    continue; // 계속 낙하
                 }
                 
-                // 다른 상자가 바로 아래에 있으면 착지
-                if (tile_below == TILE_BOX) {
-                    map->boxes[i].vy = 0;
-                    vy_accumulator[i] = 0.0f;
-                    break;
-                }
-                
-                // 바로 아래가 빈 공간이면 계속 낙하 (보석은 이제 타일에 없음)
-                if (tile_below == TILE_EMPTY || tile_below == TILE_SWITCH || tile_below == TILE_BOX_SWITCH ||
-                    tile_below == TILE_FIREBOY_START || tile_below == TILE_WATERGIRL_START) {
-                    
-                    // 계속 낙하
-                    if (map_move_box(map, i, box_x, new_y)) {
-                        box_y = new_y; // 위치 업데이트
-                        vy_accumulator[i] -= 1.0f;
-                        continue; // 계속 낙하
-                    } else {
-                        // 이동 실패 시 멈춤
-                        map->boxes[i].vy = 0;
-                        vy_accumulator[i] = 0.0f;
-                        break;
-                    }
-                }
-                
-                // 기타 경우도 멈춤
+                // 그 외에는 멈춤
                 map->boxes[i].vy = 0;
-                vy_accumulator[i] = 0.0f;
+                *vy_accumulator = 0.0f;
                 break;
             }
         }
-    }
+        }
+        
+        // 지면 위에 멈췄으면 잠듦 (이후 틱은 발밑이 바뀌기 전까지 아무 변화가 없음)
+        if (map->boxes[i].vy == 0.0f && box_is_on_ground(map, map->boxes[i].x, map->boxes[i].y)) {
+            map->awake_boxes &= ~(1ULL << i);
+        }
     }
 }
 
@@ -660,15 +1122,14 @@ void map_update_boxes(Map* map, float delta_time) {
 void map_reset_boxes(Map* map) {
     if (!map) return;
     
-    // 모든 상자의 속도를 0으로 초기화
+    // 모든 상자의 속도와 누적 이동량을 0으로 초기화하고 깨움
     for (int i = 0; i < map->box_count; i++) {
         if (map->boxes[i].active) {
             map->boxes[i].vy = 0.0f;
+            map->boxes[i].vy_accumulator = 0.0f;
+            map->awake_boxes |= 1ULL << i;
         }
     }
-    
-    // static 변수 리셋을 위해 중력 업데이트를 한 번 호출 (누적값 초기화 효과)
-    // 실제로는 다음 프레임부터 중력이 적용됨
 }
 
 // 스위치/도어 관련 헬퍼 구현
@@ -693,41 +1154,69 @@ bool map_is_switch_activated(const Map* map, int index) {
 }
 
 int map_find_switch(const Map* map, int x, int y) {
-    if (!map) return -1;
-    for (int i = 0; i < map->switch_count; i++) {
-        if (map->switches[i].x == x && map->switches[i].y == y) {
-            return i;
-        }
-    }
-    return -1;
+    if (!map || (unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height) return -1;
+    return (int)CELL_AT(map, x, y).sw - 1;
 }
 
 // 스위치 활성화 체크 (플레이어나 상자가 스위치 위에 있는지 확인)
+// 상자가 움직였거나 플레이어가 움직인 칸의 스위치만 다시 계산하고, 신호가 바뀌면 구독자에게 알림
 void map_update_switches(Map* map, int fireboy_x, int fireboy_y, int watergirl_x, int watergirl_y) {
     if (!map) return;
     
-    for (int i = 0; i < map->switch_count; i++) {
+    // 플레이어가 움직였으면 떠난 칸과 들어간 칸의 스위치를 다시 계산
+    int player_x[2] = { fireboy_x, watergirl_x };
+    int player_y[2] = { fireboy_y, watergirl_y };
+    for (int p = 0; p < 2; p++) {
+        if (player_x[p] == map->switch_player_x[p] && player_y[p] == map->switch_player_y[p]) continue;
+        map_mark_switch_dirty(map, map->switch_player_x[p], map->switch_player_y[p]);
+        map_mark_switch_dirty(map, player_x[p], player_y[p]);
+        map->switch_player_x[p] = player_x[p];
+        map->switch_player_y[p] = player_y[p];
+    }
+    
+    uint64_t old_bits[LOGIC_PLANE_COUNT] = { map->signal_bits[0], map->signal_bits[1] };
+    for (int d = 0; d < map->dirty_switch_count; d++) {
+        int i = map->dirty_switches[d];
         int switch_x = map->switches[i].x;
         int switch_y = map->switches[i].y;
+        map->switches[i].dirty = false;
         
+        bool boxed = CELL_AT(map, switch_x, switch_y).box != 0;
+        bool activated;
         if (map->switches[i].is_box_switch) {
             // 상자 스위치: 상자만 활성화 가능
-            bool box_on_switch = false;
-            for (int j = 0; j < map->box_count; j++) {
-                if (map->boxes[j].active && 
-                    map->boxes[j].x == switch_x && map->boxes[j].y == switch_y) {
-                    box_on_switch = true;
-                    break;
-                }
-            }
-            map->switches[i].activated = box_on_switch;
+            activated = boxed;
         } else {
             // 플레이어 스위치: 플레이어만 활성화 가능
-            bool player_on_switch = (fireboy_x == switch_x && fireboy_y == switch_y) ||
-                                    (watergirl_x == switch_x && watergirl_y == switch_y);
-            map->switches[i].activated = player_on_switch;
+            activated = (fireboy_x == switch_x && fireboy_y == switch_y) ||
+                        (watergirl_x == switch_x && watergirl_y == switch_y);
+        }
+        
+        int g = map->switches[i].group;
+        if (map->switches[i].activated != activated) {
+            trace_instant("switch_toggle", i);
+            map->switches[i].activated = activated;
+            map->groups[g].active_count += activated ? 1 : -1;
+        }
+        if (map->switches[i].boxed != boxed) {
+            map->switches[i].boxed = boxed;
+            map->groups[g].boxed_count += boxed ? 1 : -1;
         }
+        
+        // 그룹 신호 비트 갱신
+        uint64_t bit = 1ULL << g;
+        if (map->groups[g].active_count > 0) map->signal_bits[0] |= bit; else map->signal_bits[0] &= ~bit;
+        if (map->groups[g].boxed_count > 0) map->signal_bits[1] |= bit; else map->signal_bits[1] &= ~bit;
+    }
+    map->dirty_switch_count = 0;
+    
+    // 그룹 신호가 바뀌었거나 LATCH 타이머가 돌고 있을 때만 게이트 평가
+    bool groups_changed = old_bits[0] != map->signal_bits[0] || old_bits[1] != map->signal_bits[1];
+    if (map->logic.gate_count > 0 && (groups_changed || map->logic.timers_active)) {
+        logic_evaluate(&map->logic, map->signal_bits);
     }
+    
+    map_publish_signals(map, old_bits);
 }
 
 // 이동 발판 업데이트 (좌우/위아래 왕복 + 위에 있는 플레이어 함께 이동)
@@ -735,6 +1224,9 @@ void map_update_platforms(Map* map, float delta_time, struct Player* fireboy, st
     if (!map) return;
     
     for (int i = 0; i < map->platform_count; i++) {
+        // 직전 위치 저장 (렌더러가 두 상태 사이를 보간)
+        map->platforms[i].prev_x = map->platforms[i].x;
+        map->platforms[i].prev_y = map->platforms[i].y;
         if (!map->platforms[i].active) continue;
         
         float old_fx = map->platforms[i].x;
@@ -761,8 +1253,7 @@ void map_update_platforms(Map* map, float delta_time, struct Player* fireboy, st
             // 벽/바닥 충돌 체크
             int check_y = (int)roundf(new_fy);
             if (check_y >= 0 && check_y < map->height) {
-                TileType tile_at_target = map_get_tile(map, old_x, check_y);
-                if (tile_at_target == TILE_WALL || tile_at_target == TILE_FLOOR) {
+                if (map_get_tile_flags(map, old_x, check_y) & TILE_FLAG_BLOCKS_PLATFORM) {
                     // 벽이나 바닥에 부딪히면 방향 반전하고 이전 위치 유지
                     map->platforms[i].vy = -map->platforms[i].vy;
                     new_fy = old_fy;
@@ -784,8 +1275,7 @@ void map_update_platforms(Map* map, float delta_time, struct Player* fireboy, st
             // 벽/바닥 충돌 체크
             int check_x = (int)roundf(new_fx);
             if (check_x >= 0 && check_x < map->width) {
-                TileType tile_at_target = map_get_tile(map, check_x, old_y);
-                if (tile_at_target == TILE_WALL || tile_at_target == TILE_FLOOR) {
+                if (map_get_tile_flags(map, check_x, old_y) & TILE_FLAG_BLOCKS_PLATFORM) {
                     // 벽이나 바닥에 부딪히면 방향 반전하고 이전 위치 유지
                     map->platforms[i].vx = -map->platforms[i].vx;
                     new_fx = old_fx;
@@ -817,8 +1307,7 @@ void map_update_platforms(Map* map, float delta_time, struct Player* fireboy, st
                 int target_y = pl->y + delta_y;
                 if (target_x >= 0 && target_x < map->width &&
                     target_y >= 0 && target_y < map->height) {
-                    TileType t = map_get_tile(map, target_x, target_y);
-                    if (t != TILE_WALL && t != TILE_FLOOR) {
+                    if (!(map_get_tile_flags(map, target_x, target_y) & TILE_FLAG_BLOCKS_PLATFORM)) {
                         pl->x = target_x;
                         pl->y = target_y;
                         // 발판과 함께 이동할 때 수직 속도를 0으로 (중력 무효화)
@@ -832,6 +1321,12 @@ void map_update_platforms(Map* map, float delta_time, struct Player* fireboy, st
         // 타일 배열은 건드리지 않음! 렌더러에서 오버레이로 그림
         map->platforms[i].x = new_fx;
         map->platforms[i].y = new_fy;
+        
+        // 덮은 칸이 바뀌었을 때만 지면 비트맵 갱신
+        if (new_x != old_x || new_y != old_y) {
+            map_add_platform_cells(map, old_x, 1, old_y, -1);
+            map_add_platform_cells(map, new_x, 1, new_y, 1);
+        }
     }
 }
 
@@ -842,33 +1337,11 @@ void map_update_toggle_platforms(Map* map, float delta_time) {
     const float platform_speed = 3.0f; // 초당 3타일 이동
     
     for (int i = 0; i < map->toggle_platform_count; i++) {
-        // 그룹 ID로 스위치 체크 (같은 그룹의 스위치 중 하나라도 활성화되면 동작)
-        bool switch_on = false;
+        // 직전 위치 저장 (렌더러가 두 상태 사이를 보간)
+        map->toggle_platforms[i].prev_y = map->toggle_platforms[i].y;
         
-        if (map->toggle_platforms[i].linked_group[0] != '\0') {
-            // 그룹 ID가 있으면 같은 그룹의 모든 스위치 체크
-            for (int si = 0; si < map->switch_count; si++) {
-                if (strcmp(map->switches[si].group_id, map->toggle_platforms[i].linked_group) == 0) {
-                    if (map->switches[si].activated) {
-                        switch_on = true;
-                        break;
-                    }
-                }
-            }
-        } else {
-            // 하위 호환성: 그룹 ID가 없으면 linked_switch 사용
-            int switch_idx = map->toggle_platforms[i].linked_switch;
-            if (switch_idx >= 0 && switch_idx < map->switch_count) {
-                switch_on = map->switches[switch_idx].activated;
-            }
-        }
-        
-        bool should_be_down = switch_on;
-        
-        // 목표 상태가 바뀌면 이동 시작
-        if (should_be_down != map->toggle_platforms[i].target_is_down) {
-            map->toggle_platforms[i].target_is_down = should_be_down;
-        }
+        // 목표 상태는 구독한 그룹이 바뀔 때 map_update_switches가 갱신
+        bool should_be_down = map->toggle_platforms[i].target_is_down;
         
         // 현재 목표 위치
         float target = should_be_down ? 
@@ -877,6 +1350,7 @@ void map_update_toggle_platforms(Map* map, float delta_time) {
         
         // 현재 위치
         float current = map->toggle_platforms[i].y;
+        int old_row = (int)roundf(current);
         
         // 목표에 도달하지 않았으면 이동
         if (fabsf(current - target) > 0.1f) {
@@ -893,91 +1367,34 @@ void map_update_toggle_platforms(Map* map, float delta_time) {
                     map->toggle_platforms[i].y = target;
                 }
             }
+            
+            // 덮은 줄이 바뀌었을 때만 지면 비트맵 갱신
+            int new_row = (int)roundf(map->toggle_platforms[i].y);
+            if (new_row != old_row) {
+                map_add_platform_cells(map, map->toggle_platforms[i].x, map->toggle_platforms[i].width, old_row, -1);
+                map_add_platform_cells(map, map->toggle_platforms[i].x, map->toggle_platforms[i].width, new_row, 1);
+            }
         }
     }
 }
 
-// 수직 벽 업데이트
+// 수직 벽 업데이트 (열림/닫힘 목표가 바뀐 벽만 타일을 고침)
 void map_update_vertical_walls(Map* map, float delta_time) {
     if (!map) return;
-    (void)delta_time; // 경고 방지
+    (void)delta_time; // 벽 애니메이션은 틱 단위
     
-    for (int i = 0; i < map->vertical_wall_count; i++) {
-        // 그룹 ID로 스위치 체크 (같은 그룹의 스위치 중 하나라도 박스가 있으면 벽 사라짐)
-        bool should_hide = false;
-        
-        if (map->vertical_walls[i].linked_group[0] != '\0') {
-            // 그룹 ID가 있으면 같은 그룹의 모든 스위치 체크
-            for (int si = 0; si < map->switch_count; si++) {
-                if (strcmp(map->switches[si].group_id, map->vertical_walls[i].linked_group) == 0) {
-                    // 해당 스위치에 박스가 있는지 확인
-                    int switch_x = map->switches[si].x;
-                    int switch_y = map->switches[si].y;
-                    for (int j = 0; j < map->box_count; j++) {
-                        if (map->boxes[j].active && 
-                            map->boxes[j].x == switch_x && map->boxes[j].y == switch_y) {
-                            should_hide = true;
-                            break;
-                        }
-                    }
-                    if (should_hide) break;
-                }
-            }
-        } else {
-            // 하위 호환성: 그룹 ID가 없으면 linked_switch 사용
-            int switch_idx = map->vertical_walls[i].linked_switch;
-            if (switch_idx >= 0 && switch_idx < map->switch_count) {
-                int switch_x = map->switches[switch_idx].x;
-                int switch_y = map->switches[switch_idx].y;
-                for (int j = 0; j < map->box_count; j++) {
-                    if (map->boxes[j].active && 
-                        map->boxes[j].x == switch_x && map->boxes[j].y == switch_y) {
-                        should_hide = true;
-                        break;
-                    }
-                }
-            }
-        }
-        
-        // V 벽이 사라져야 하는지 확인
-        int wall_x = map->vertical_walls[i].x;
-        int orig_y = map->vertical_walls[i].original_y;
-        int target_y = map->vertical_walls[i].target_y;
-        
-        // 벽이 있는 전체 범위 (original_y ~ target_y)
-        int min_y = (orig_y < target_y) ? orig_y : target_y;
-        int max_y = (orig_y > target_y) ? orig_y : target_y;
-        
-        if (should_hide) {
-            // 박스가 스위치 위에 있으면 V 벽 전체를 EMPTY로 변경 (사라짐)
-            for (int y = min_y; y <= max_y; y++) {
-                if (y >= 0 && y < map->height && wall_x >= 0 && wall_x < map->width) {
-                    map->tiles[y][wall_x] = TILE_EMPTY;
-                }
-            }
-        } else {
-            // 박스가 없으면 V 벽을 다시 표시 (original_y부터 target_y까지)
-            for (int y = orig_y; y <= target_y; y++) {
-                if (y >= 0 && y < map->height && wall_x >= 0 && wall_x < map->width) {
-                    map->tiles[y][wall_x] = TILE_VERTICAL_WALL;
-                }
-            }
-        }
+    uint32_t moving = map->moving_walls;
+    while (moving) {
+        int i = __builtin_ctz(moving);
+        moving &= moving - 1;
+        map_step_vertical_wall(map, i, false);
     }
 }
 
 // 특정 위치에 수집되지 않은 보석이 있는지 확인
 int map_find_gem_at(const Map* map, int x, int y) {
-    if (!map) return -1;
-    
-    for (int i = 0; i < map->gem_count; i++) {
-        if (!map->gems[i].collected &&
-            map->gems[i].x == x &&
-            map->gems[i].y == y) {
-            return i;
-        }
-    }
-    return -1;
+    if (!map || (unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height) return -1;
+    return (int)CELL_AT(map, x, y).gem - 1; // 수집된 보석은 색인에서 빠짐
 }
 
 // 보석 수집 (색상 체크 포함)
@@ -993,9 +1410,57 @@ bool map_collect_gem(Map* map, int x, int y, bool is_fireboy) {
     if ((is_fireboy && gem_type == TILE_FIRE_GEM) ||
         (!is_fireboy && gem_type == TILE_WATER_GEM)) {
         map->gems[gem_idx].collected = true;
+        CELL_AT(map, x, y).gem = 0;
         return true;
     }
     
     return false;
 }
 
+// 보석을 모두 모았는지 확인 (보석이 없는 맵은 false)
+bool map_all_gems_collected(const Map* map) {
+    if (!map || map->gem_count == 0) return false;
+    for (int i = 0; i < map->gem_count; i++) {
+        if (!map->gems[i].collected) return false;
+    }
+    return true;
+}
+
+// 스위치가 하나라도 눌려 있는지 확인
+bool map_any_switch_activated(const Map* map) {
+    if (!map) return false;
+    for (int i = 0; i < map->switch_count; i++) {
+        if (map->switches[i].activated) return true;
+    }
+    return false;
+}
+
+// 맵이 정지 상태인지 확인 (움직이는 발판/토글 발판/낙하 중인 상자가 없으면 true)
+bool map_is_quiescent(const Map* map) {
+    if (!map) return true;
+    
+    // 이동 발판은 활성화되어 있는 동안 계속 왕복하므로 정지 상태가 아님
+    for (int i = 0; i < map->platform_count; i++) {
+        if (map->platforms[i].active) return false;
+    }
+
+    // 한 줄씩 여닫히는 중인 수직 벽, 유지 시간이 남은 LATCH가 있으면 입력이 없어도 매 틱 바뀜
+    if (map->moving_walls || map->logic.timers_active) return false;
+
+    // 토글 발판은 스위치 상태에 맞는 목표 위치에 도착해 있어야 함
+    for (int i = 0; i < map->toggle_platform_count; i++) {
+        float target = map->toggle_platforms[i].target_is_down ?
+            (float)map->toggle_platforms[i].target_y :
+            (float)map->toggle_platforms[i].original_y;
+        if (fabsf(map->toggle_platforms[i].y - target) > 0.1f) return false;
+    }
+    
+    // 상자는 지면 위에 멈춰 있어야 함 (잠든 상자는 이미 멈춰 있으므로 깨어 있는 상자만 확인)
+    for (int i = 0; i < map->box_count; i++) {
+        if (!map->boxes[i].active || !((map->awake_boxes >> i) & 1)) continue;
+        if (map->boxes[i].vy != 0.0f) return false;
+        if (!box_is_on_ground(map, map->boxes[i].x, map->boxes[i].y)) return false;
+    }
+    
+    return true;
+}
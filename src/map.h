@@ -2,53 +2,106 @@
 #define MAP_H
 
 #include "common.h"
+#include "logic.h"
+#include <stdint.h>
 
-// 타일 종류
+// 타일 성질 비트 (충돌/위험 판정은 tile_flags 표를 한 번 읽고 마스크로 검사)
+#define TILE_FLAG_AIR                 0x0001u // 아무것도 없음 (딛고 설 수 없음)
+#define TILE_FLAG_SOLID               0x0002u // 항상 막힘 (좌우 이동, 낙하, 천장)
+#define TILE_FLAG_SOLID_WHEN_GROUNDED 0x0004u // 지상에서 옆으로 갈 때와 천장으로만 막힘
+#define TILE_FLAG_LANDABLE            0x0008u // 낙하 중 이 타일 위에 착지
+#define TILE_FLAG_LANDABLE_FIRE       0x0010u // Fireboy만 위에 착지
+#define TILE_FLAG_LANDABLE_WATER      0x0020u // Watergirl만 위에 착지
+#define TILE_FLAG_DEADLY_TO_FIRE      0x0040u // 닿으면 Fireboy 사망
+#define TILE_FLAG_DEADLY_TO_WATER     0x0080u // 닿으면 Watergirl 사망
+#define TILE_FLAG_PUSHABLE            0x0100u // 플레이어가 밀 수 있음
+#define TILE_FLAG_BOX_PASSABLE        0x0200u // 상자가 들어갈 수 있음
+#define TILE_FLAG_BOX_SUPPORT         0x0400u // 상자가 그 위에 멈춤
+#define TILE_FLAG_BLOCKS_PLATFORM     0x0800u // 이동 발판이 부딪혀 방향을 바꿈
+
+// 타일 등록표: 이름, 맵 문자, 성질
+// TileType 값과 tile_flags 표가 모두 여기서 만들어지므로 새 타일은 한 줄만 추가하면 됨
+#define TILE_REGISTRY(X) \
+    /* === 기본 타일 === */ \
+    X(TILE_EMPTY,               ' ', TILE_FLAG_AIR | TILE_FLAG_BOX_PASSABLE)                    /* 빈 공간 */ \
+    X(TILE_WALL,                '#', TILE_FLAG_SOLID | TILE_FLAG_LANDABLE |                       \
+                                     TILE_FLAG_BOX_SUPPORT | TILE_FLAG_BLOCKS_PLATFORM)           /* 벽 */ \
+    X(TILE_FLOOR,               '.', TILE_FLAG_SOLID_WHEN_GROUNDED | TILE_FLAG_LANDABLE |         \
+                                     TILE_FLAG_BOX_SUPPORT | TILE_FLAG_BLOCKS_PLATFORM)           /* 바닥 */ \
+    /* === 지형 (속성) === */ \
+    X(TILE_FIRE_TERRAIN,        'F', TILE_FLAG_LANDABLE_FIRE | TILE_FLAG_DEADLY_TO_WATER)        /* 불 지형 (Fireboy만 통과 가능) */ \
+    X(TILE_WATER_TERRAIN,       'W', TILE_FLAG_LANDABLE_WATER | TILE_FLAG_DEADLY_TO_FIRE)        /* 물 지형 (Watergirl만 통과 가능) */ \
+    X(TILE_POISON_TERRAIN,      'Z', TILE_FLAG_DEADLY_TO_FIRE | TILE_FLAG_DEADLY_TO_WATER)       /* 독 지형 (모든 플레이어 사망) */ \
+    /* === 오브젝트 === */ \
+    X(TILE_BOX,                 'B', TILE_FLAG_PUSHABLE | TILE_FLAG_BOX_SUPPORT)                 /* 상자 */ \
+    /* === 스위치 === */ \
+    X(TILE_SWITCH,              'S', TILE_FLAG_BOX_PASSABLE | TILE_FLAG_BOX_SUPPORT)             /* 플레이어 스위치 */ \
+    X(TILE_BOX_SWITCH,          'X', TILE_FLAG_BOX_PASSABLE | TILE_FLAG_BOX_SUPPORT)             /* 상자 스위치 */ \
+    /* === 발판 (이동) === */ \
+    X(TILE_MOVING_PLATFORM,     'P', 0)                                                          /* 세로 이동 발판 (위아래) */ \
+    X(TILE_HORIZONTAL_PLATFORM, 'H', 0)                                                          /* 가로 이동 발판 (좌우) */ \
+    /* === 발판 (토글) === */ \
+    X(TILE_TOGGLE_PLATFORM,     'T', 0)                                                          /* 토글 발판 (스위치로 제어) */ \
+    X(TILE_TOGGLE_TARGET,       't', 0)                                                          /* 토글 발판 목표 위치 */ \
+    /* === 수직 벽 === */ \
+    X(TILE_VERTICAL_WALL,       'V', TILE_FLAG_SOLID | TILE_FLAG_LANDABLE)                       /* 수직 이동 벽 */ \
+    X(TILE_VERTICAL_TARGET,     'v', 0)                                                          /* 수직 벽 목표 위치 */ \
+    /* === 보석 === */ \
+    X(TILE_FIRE_GEM,            'R', 0)                                                          /* Fireboy 전용 보석 (빨강) */ \
+    X(TILE_WATER_GEM,           'b', 0)                                                          /* Watergirl 전용 보석 (파랑) */ \
+    /* === 시작/출구 === */ \
+    X(TILE_FIREBOY_START,       'f', TILE_FLAG_LANDABLE)                                         /* Fireboy 시작 위치 */ \
+    X(TILE_WATERGIRL_START,     'w', TILE_FLAG_LANDABLE)                                         /* Watergirl 시작 위치 */ \
+    X(TILE_EXIT,                'E', 0)                                                          /* 출구 */
+
+// 타일 종류 (값은 맵 파일의 문자)
 typedef enum {
-    // === 기본 타일 ===
-    TILE_EMPTY = ' ',               // 빈 공간
-    TILE_WALL = '#',                // 벽
-    TILE_FLOOR = '.',               // 바닥
-    
-    // === 지형 (속성) ===
-    TILE_FIRE_TERRAIN = 'F',        // 불 지형 (Fireboy만 통과 가능)
-    TILE_WATER_TERRAIN = 'W',       // 물 지형 (Watergirl만 통과 가능)
-    TILE_POISON_TERRAIN = 'Z',      // 독 지형 (모든 플레이어 사망)
-    
-    // === 오브젝트 ===
-    TILE_BOX = 'B',                 // 상자
-    
-    // === 스위치 ===
-    TILE_SWITCH = 'S',              // 플레이어 스위치
-    TILE_BOX_SWITCH = 'X',          // 상자 스위치
-    
-    // === 발판 (이동) ===
-    TILE_MOVING_PLATFORM = 'P',     // 세로 이동 발판 (위아래)
-    TILE_HORIZONTAL_PLATFORM = 'H', // 가로 이동 발판 (좌우)
-    
-    // === 발판 (토글) ===
-    TILE_TOGGLE_PLATFORM = 'T',     // 토글 발판 (스위치로 제어)
-    TILE_TOGGLE_TARGET = 't',       // 토글 발판 목표 위치
-    
-    // === 수직 벽 ===
-    TILE_VERTICAL_WALL = 'V',       // 수직 이동 벽
-    TILE_VERTICAL_TARGET = 'v',     // 수직 벽 목표 위치
-    
-    // === 보석 ===
-    TILE_FIRE_GEM = 'R',            // Fireboy 전용 보석 (빨강)
-    TILE_WATER_GEM = 'b',           // Watergirl 전용 보석 (파랑)
-    
-    // === 시작/출구 ===
-    TILE_FIREBOY_START = 'f',       // Fireboy 시작 위치
-    TILE_WATERGIRL_START = 'w',     // Watergirl 시작 위치
-    TILE_EXIT = 'E'                 // 출구
+#define TILE_ENUM_ENTRY(name, ch, flags) name = (ch),
+    TILE_REGISTRY(TILE_ENUM_ENTRY)
+#undef TILE_ENUM_ENTRY
 } TileType;
 
+// 타일 문자 -> 성질 비트 (등록되지 않은 문자는 0)
+extern const uint16_t tile_flags[256];
+
+static inline uint16_t tile_get_flags(TileType tile) {
+    return tile_flags[(uint8_t)tile];
+}
+
+// 칸 점유 색인 (엔티티 인덱스 + 1, 0이면 없음)
+// 상자는 스위치나 보석과 같은 칸에 겹칠 수 있으므로 종류별로 따로 둠
+typedef struct {
+    uint8_t box;
+    uint8_t sw;
+    uint8_t gem;
+    uint8_t platforms;  // 이 칸을 덮은 이동/토글 발판 수
+} MapCell;
+
+// 통과 판정 비트 평면 (타일 성질을 평면마다 비트 하나로 모음)
+// 캐릭터별 평면은 Fireboy 다음에 Watergirl 순서 (MAP_PLANE_LANDABLE_FIRE + 플레이어 인덱스)
+typedef enum {
+    MAP_PLANE_AIR,              // 빈 공간 (맵 밖 여백 비트도 1)
+    MAP_PLANE_SOLID,            // 항상 막힘
+    MAP_PLANE_FLOOR,            // 지상에서만 막힘 (바닥 타일)
+    MAP_PLANE_PUSHABLE,         // 밀 수 있음 (상자)
+    MAP_PLANE_LANDABLE_FIRE,    // 착지 가능 (공통 + 자기 속성 지형)
+    MAP_PLANE_LANDABLE_WATER,
+    MAP_PLANE_DEADLY_FIRE,      // 닿으면 사망
+    MAP_PLANE_DEADLY_WATER,
+    MAP_PLANE_COUNT
+} MapPlane;
+
 // 맵 구조체
 typedef struct {
     int width;
     int height;
-    TileType** tiles;  // 2D 배열
+    uint8_t* tiles;    // 행 우선 1차원 배열 (인덱스 y * width + x, 값은 타일 문자)
+    MapCell* cells;    // tiles와 같은 인덱스의 칸 점유 색인 (map_move_box와 보석 수집이 갱신)
+    uint64_t* footing; // 딛고 설 수 있는 칸 비트맵 (같은 인덱스, 타일 변경과 발판 이동 때만 해당 칸을 갱신)
+    uint64_t* row_planes; // 평면별 행 우선 비트 (평면 p, y행은 [(p * height + y) * row_words]부터, 가로 스캔용)
+    uint64_t* col_planes; // 평면별 열 우선 비트 (평면 p, x열은 [(p * width + x) * col_words]부터, 세로 스캔용)
+    int row_words;     // 한 행의 워드 수 (폭 100이면 2)
+    int col_words;     // 한 열의 워드 수 (높이 64 이하면 1)
     int fireboy_start_x;
     int fireboy_start_y;
     int watergirl_start_x;
@@ -62,8 +115,10 @@ typedef struct {
         int x;
         int y;
         float vy;
+        float vy_accumulator;  // 1칸 미만 이동량 누적
         bool active;
     } boxes[MAX_BOXES];
+    uint64_t awake_boxes;  // 깨어 있는 상자 비트 (비트 i = boxes[i], 잠든 상자는 map_update_boxes가 건너뜀)
 
     // 보석 정보 (박스와 독립적으로 관리)
     int gem_count;
@@ -82,14 +137,38 @@ typedef struct {
         bool activated;
         bool toggle_state;
         bool is_box_switch;  // true면 상자 스위치, false면 플레이어 스위치
-        char group_id[32];  // 스위치 그룹 ID (예: "PLATFORM_1")
+        bool boxed;          // 상자가 올라가 있는지 (수직 벽 제어용)
+        bool dirty;          // 다음 map_update_switches에서 다시 계산할지
+        int group;           // 소속 그룹 인덱스 (이름 없는 스위치는 혼자 한 그룹)
     } switches[MAX_SWITCHES];
 
+    // 다시 계산할 스위치 목록 (상자 이동, 플레이어 이동이 있을 때만 채워짐)
+    int dirty_switch_count;
+    uint8_t dirty_switches[MAX_SWITCHES];
+    int switch_player_x[2]; // 직전 map_update_switches의 플레이어 위치 (Fireboy, Watergirl)
+    int switch_player_y[2];
+
+    // 스위치 그룹 (로드 시 # GROUPS의 그룹 ID를 작은 정수로 인턴, 그룹 g는 신호 비트 g)
+    int group_count;
+    struct {
+        char name[32];      // 그룹 ID (이름 없는 단일 스위치 그룹은 빈 문자열)
+        int active_count;   // 눌린 스위치 수
+        int boxed_count;    // 상자가 올라간 스위치 수
+    } groups[MAX_SWITCHES];
+
+    // 그룹 위의 논리 게이트 (게이트 k의 출력은 신호 비트 group_count + k)
+    LogicNetwork logic;
+    uint64_t signal_bits[LOGIC_PLANE_COUNT];  // 신호 값 (평면 0: 눌림 -> 토글 발판, 평면 1: 상자 -> 수직 벽)
+    uint32_t toggle_subscribers[LOGIC_MAX_SIGNALS]; // 신호별 구독 토글 발판 비트 (로드 시 채움)
+    uint32_t wall_subscribers[LOGIC_MAX_SIGNALS];   // 신호별 구독 수직 벽 비트
+
     // 이동 발판 정보
     int platform_count;
     struct {
         float x;
         float y;
+        float prev_x;  // 직전 틱 위치 (렌더링 보간용)
+        float prev_y;
         float vx;
         float vy;
         int min_x;
@@ -106,12 +185,13 @@ typedef struct {
         int x;
         int width;
         float y;
+        float prev_y;  // 직전 틱 위치 (렌더링 보간용)
         int original_y;
         int target_y;
         bool moving_down;
-        bool target_is_down;
-        int linked_switch;  // 하위 호환성을 위해 유지
-        char linked_group[32];  // 구독할 스위치 그룹 ID
+        bool target_is_down;  // 구독한 신호가 켜져 있는지 (신호가 바뀔 때 갱신)
+        int linked_switch;  // 가장 가까운 스위치 (T 줄이 없으면 이 스위치의 그룹을 구독)
+        int signal;         // 구독한 신호 비트 (없으면 -1)
     } toggle_platforms[MAX_PLATFORMS];
     
     // 수직 이동 벽 정보
@@ -121,10 +201,17 @@ typedef struct {
         float y;
         int original_y;
         int target_y;
-        bool is_up;
-        int linked_switch;  // 하위 호환성을 위해 유지
-        char linked_group[32];  // 구독할 스위치 그룹 ID
+        bool hidden;        // 구독한 신호가 켜져 있는지 = 열려야 하는지 (신호가 바뀔 때 갱신)
+        int open_rows;      // 현재 열린(사라진) 줄 수 (0이면 닫힘, 벽 높이와 같으면 완전히 열림)
+        int step_ticks;     // 한 줄 여닫는 데 걸리는 틱 수 (0이면 한 번에, # GROUPS의 V 줄로 지정)
+        int step_timer;     // 다음 줄을 여닫기까지 남은 틱
+        int linked_switch;  // 가장 가까운 스위치 (V 줄이 없으면 이 스위치의 그룹을 구독)
+        int signal;         // 구독한 신호 비트 (없으면 -1)
     } vertical_walls[MAX_PLATFORMS];
+    uint32_t moving_walls;  // 열림/닫힘이 목표와 다른 벽 비트 (이 벽들만 map_update_vertical_walls가 처리)
+
+    // 리셋용 원본 스냅샷 (로드 직후 상태, map_reset에서 사용)
+    struct MapSnapshot* snapshot;
 } Map;
 
 // 전방 선언
@@ -134,9 +221,46 @@ typedef struct Player Player;
 Map* map_create(int width, int height);
 void map_destroy(Map* map);
 Map* map_load_from_file(const char* filename);
-TileType map_get_tile(const Map* map, int x, int y);
+// 백그라운드 스레드용: 화면에 끼어들지 않도록 진단 메시지를 출력하지 않고, 출력할 것이 있었으면 *suppressed = true
+Map* map_load_from_file_quiet(const char* filename, bool* suppressed);
 void map_set_tile(Map* map, int x, int y, TileType tile);
 
+// 스냅샷/리셋 (리스폰 시 파일을 다시 읽지 않고 로드 직후 상태로 복원)
+bool map_save_snapshot(Map* map);
+bool map_reset(Map* map);
+
+// 타일 가져오기 (맵 밖은 빈 공간, 충돌 검사에서 자주 불리므로 인라인)
+static inline TileType map_get_tile(const Map* map, int x, int y) {
+    if ((unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height) {
+        return TILE_EMPTY;
+    }
+    return (TileType)map->tiles[(size_t)y * (size_t)map->width + (size_t)x];
+}
+
+// 타일 성질 비트 가져오기 (맵 밖은 빈 공간의 성질)
+static inline uint16_t map_get_tile_flags(const Map* map, int x, int y) {
+    return tile_get_flags(map_get_tile(map, x, y));
+}
+
+// (x, y)에 선 캐릭터가 지면 위에 있는지 (발밑 타일, 바닥 타일, 발판을 미리 합쳐 둔 비트 하나)
+static inline bool map_has_footing(const Map* map, int x, int y) {
+    if ((unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height) {
+        return false;
+    }
+    size_t i = (size_t)y * (size_t)map->width + (size_t)x;
+    return (map->footing[i >> 6] >> (i & 63)) & 1;
+}
+
+// 비트 평면 스캔 (player_idx: 0 = Fireboy, 1 = Watergirl)
+// (x, y)에서 아래로 착지/충돌/위험 지형 없이 지나갈 수 있는 줄 수
+int map_fall_run(const Map* map, int player_idx, int x, int y);
+// (x, y)에서 위로 천장(벽/바닥 타일) 없이 올라갈 수 있는 줄 수
+int map_rise_run(const Map* map, int x, int y);
+// (x, y)에서 dir(+1/-1) 방향으로 벽, 상자, 위험 지형 (지상이면 바닥 타일도) 없이 걸어갈 수 있는 칸 수
+int map_walk_run(const Map* map, int player_idx, int x, int y, int dir, bool grounded);
+// (x, y) 또는 발밑이 캐릭터에게 치명적인 지형인지
+bool map_touches_hazard(const Map* map, int player_idx, int x, int y);
+
 // 상자 관련
 int map_get_box_count(const Map* map);
 int map_get_box_x(const Map* map, int index);
@@ -153,14 +277,19 @@ int map_get_switch_y(const Map* map, int index);
 bool map_is_switch_activated(const Map* map, int index);
 int map_find_switch(const Map* map, int x, int y);
 void map_update_switches(Map* map, int fireboy_x, int fireboy_y, int watergirl_x, int watergirl_y);
+bool map_any_switch_activated(const Map* map);
 
 // 보석 관련
 int map_find_gem_at(const Map* map, int x, int y);
 bool map_collect_gem(Map* map, int x, int y, bool is_fireboy);
+bool map_all_gems_collected(const Map* map);
 
 // 발판 관련
 void map_update_platforms(Map* map, float delta_time, struct Player* fireboy, struct Player* watergirl);
 void map_update_toggle_platforms(Map* map, float delta_time);
 void map_update_vertical_walls(Map* map, float delta_time);
 
+// 정지 상태 판정 (유휴 프레임 생략용)
+bool map_is_quiescent(const Map* map);
+
 #endif // MAP_H
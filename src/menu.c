@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <errno.h>
 
 // ============================================================================
 // 문자열의 화면 표시 폭 계산 (한글 2칸, ASCII 1칸)
@@ -208,6 +209,13 @@ MenuResult menu_show_main(void) {
         input_update();
         PlayerInput player_input = input_get_player_input();
         
+        // 터미널이 닫혔으면 종료
+        if (input_is_quit_requested()) {
+            result.exit_game = true;
+            result.start_game = false;
+            return result;
+        }
+        
         if (player_input.fireboy.up || player_input.watergirl.up) {
             selected = (selected - 1 + menu_count) % menu_count;
             usleep(150000);
@@ -375,7 +383,7 @@ bool menu_get_player_name(char* name, int max_length) {
     
     // 입력 버퍼 클리어
     usleep(200000);
-    tcflush(STDIN_FILENO, TCIFLUSH);
+    input_flush();
     char buffer[256] = {0};
     int buf_len = 0;  // 바이트 길이
     int char_count = 0;  // 문자 개수 (UTF-8 문자 기준)
@@ -383,7 +391,16 @@ bool menu_get_player_name(char* name, int max_length) {
     
     while (true) {
         unsigned char ch;
-        if (read(STDIN_FILENO, &ch, 1) == 1) {
+        ssize_t got = read(STDIN_FILENO, &ch, 1);
+        if (got == 0 || (got < 0 && errno != EINTR)) {
+            // 터미널이 닫힘 (EOF/EIO): 취소로 처리 (다시 시작한 입력 스레드가 종료 요청을 올림)
+            tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+            fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) & ~O_NONBLOCK);
+            input_init();
+            console_hide_cursor();
+            return false;
+        }
+        if (got == 1) {
             // ESC 키 처리
             if (ch == 27) {
                 // ESC 시퀀스 확인 (화살표 키인지 확인)
@@ -634,15 +651,15 @@ void menu_show_final_result(float stage_times[], float total_time, int total_dea
     
     // 스테이지 1, 2, 3
     console_set_color(COLOR_YELLOW, COLOR_BLACK);
-    printf("║                              스테이지 1: %.1f초                                 ║\n", stage_times[0]);
-    printf("║                              스테이지 2: %.1f초                                 ║\n", stage_times[1]);
-    printf("║                              스테이지 3: %.1f초                                 ║\n", stage_times[2]);
+    printf("║                              스테이지 1: %8.3f초                            ║\n", stage_times[0]);
+    printf("║                              스테이지 2: %8.3f초                            ║\n", stage_times[1]);
+    printf("║                              스테이지 3: %8.3f초                            ║\n", stage_times[2]);
     
     printf("║                                                                                ║\n");
     
     // 총합 통계
     console_set_color(COLOR_CYAN, COLOR_BLACK);
-    printf("║                              총 시간: %.1f초                                    ║\n", total_time);
+    printf("║                              총 시간: %8.3f초                               ║\n", total_time);
     console_set_color(COLOR_RED, COLOR_BLACK);
     printf("║                              총 사망: %d회                                      ║\n", total_deaths);
     printf("║                                                                                ║\n");
@@ -674,7 +691,7 @@ void menu_show_final_result(float stage_times[], float total_time, int total_dea
     console_set_cursor_position(0, 0);
     
     // Enter 입력 대기
-    while (true) {
+    while (!input_is_quit_requested()) {
         input_update();
         PlayerInput player_input = input_get_player_input();
         
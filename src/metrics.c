@@ -0,0 +1,181 @@
+#include "metrics.h"
+#include <stdatomic.h>
+#include <pthread.h>
+#include <poll.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// 메트릭 정의 (Prometheus 이름, 설명, 타입, 출력 배율)
+typedef struct {
+    const char* name;
+    const char* help;
+    const char* type;
+    double scale; // 저장값에 곱해서 출력 (나노초 -> 초 변환 등)
+} MetricInfo;
+
+static const MetricInfo metric_info[METRIC_COUNT] = {
+    { "fw_ticks_total",                 "Game loop ticks",                         "counter", 1.0 },
+    { "fw_sim_ticks_total",             "Fixed-step simulation ticks",             "counter", 1.0 },
+    { "fw_frame_overruns_total",        "Ticks that exceeded the frame budget",    "counter", 1.0 },
+    { "fw_render_bytes_total",          "Bytes written to the terminal",           "counter", 1.0 },
+    { "fw_render_bytes_per_second",     "Bytes written to the terminal in the last second", "gauge", 1.0 },
+    { "fw_input_events_total",          "Decoded input events",                    "counter", 1.0 },
+    { "fw_deaths_total",                "Player deaths",                           "counter", 1.0 },
+    { "fw_current_stage",               "Stage currently being played",            "gauge",   1.0 },
+    { "fw_load_stage_seconds",          "Latency of the last load_stage call",     "gauge",   1e-9 },
+    { "fw_stage_preload_hits_total",    "Stage loads served by the background loader", "counter", 1.0 },
+    { "fw_respawn_seconds",             "Latency of the last map reset on respawn", "gauge",   1e-9 },
+    { "fw_ranking_save_seconds",        "Latency of the last ranking save",        "gauge",   1e-9 }
+};
+
+// 게임 루프는 쓰기만, 서버 스레드는 읽기만 하므로 relaxed 원자 연산으로 충분
+static _Atomic uint64_t metric_values[METRIC_COUNT];
+
+static pthread_t server_thread;
+static atomic_bool server_running = false;
+static int server_fd = -1;
+static char server_path[108];
+
+void metrics_add(MetricId id, uint64_t delta) {
+    atomic_fetch_add_explicit(&metric_values[id], delta, memory_order_relaxed);
+}
+
+void metrics_set(MetricId id, uint64_t value) {
+    atomic_store_explicit(&metric_values[id], value, memory_order_relaxed);
+}
+
+uint64_t metrics_get(MetricId id) {
+    return atomic_load_explicit(&metric_values[id], memory_order_relaxed);
+}
+
+// Prometheus 텍스트 형식으로 직렬화
+static int metrics_format(char* buffer, size_t size) {
+    size_t len = 0;
+    for (int i = 0; i < METRIC_COUNT && len < size; i++) {
+        const MetricInfo* info = &metric_info[i];
+        uint64_t value = metrics_get((MetricId)i);
+        int n;
+        if (info->scale == 1.0) {
+            n = snprintf(buffer + len, size - len, "# HELP %s %s\n# TYPE %s %s\n%s %llu\n",
+                         info->name, info->help, info->name, info->type,
+                         info->name, (unsigned long long)value);
+        } else {
+            n = snprintf(buffer + len, size - len, "# HELP %s %s\n# TYPE %s %s\n%s %.9f\n",
+                         info->name, info->help, info->name, info->type,
+                         info->name, (double)value * info->scale);
+        }
+        if (n < 0) break;
+        len += (size_t)n;
+    }
+    return (int)(len < size ? len : size - 1);
+}
+
+// 끊긴 연결에 써도 SIGPIPE로 게임이 종료되지 않도록 전송
+static void send_all(int fd, const char* data, size_t len) {
+#ifdef MSG_NOSIGNAL
+    int flags = MSG_NOSIGNAL;
+#else
+    int flags = 0;
+#endif
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, flags);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+// 연결 하나 처리: HTTP 요청이면 HTTP 응답으로, 아니면 본문만 전송
+static void serve_client(int client_fd) {
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(client_fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+
+    // 요청은 짧게만 기다림 (socat처럼 아무것도 보내지 않는 클라이언트 허용)
+    char request[512];
+    ssize_t request_len = 0;
+    struct pollfd pfd = { client_fd, POLLIN, 0 };
+    if (poll(&pfd, 1, 100) > 0) {
+        request_len = recv(client_fd, request, sizeof(request) - 1, 0);
+    }
+    bool is_http = request_len >= 4 && strncmp(request, "GET ", 4) == 0;
+
+    char body[4096];
+    int body_len = metrics_format(body, sizeof(body));
+
+    if (is_http) {
+        char header[160];
+        int header_len = snprintf(header, sizeof(header),
+                                  "HTTP/1.0 200 OK\r\n"
+                                  "Content-Type: text/plain; version=0.0.4\r\n"
+                                  "Content-Length: %d\r\n\r\n", body_len);
+        send_all(client_fd, header, (size_t)header_len);
+    }
+    send_all(client_fd, body, (size_t)body_len);
+}
+
+// 서버 스레드: 종료 플래그를 주기적으로 확인하며 연결 수락
+static void* metrics_server_main(void* arg) {
+    (void)arg;
+    while (atomic_load(&server_running)) {
+        struct pollfd pfd = { server_fd, POLLIN, 0 };
+        if (poll(&pfd, 1, 200) <= 0) continue;
+
+        int client_fd = accept(server_fd, NULL, NULL);
+        if (client_fd < 0) continue;
+        serve_client(client_fd);
+        close(client_fd);
+    }
+    return NULL;
+}
+
+// 메트릭 서버 시작
+bool metrics_server_start(const char* socket_path) {
+    if (!socket_path || atomic_load(&server_running)) return false;
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) return false;
+    strncpy(addr.sun_path, socket_path, sizeof(addr.sun_path) - 1);
+
+    server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server_fd < 0) return false;
+
+    unlink(socket_path); // 이전 실행에서 남은 소켓 파일 제거
+    if (bind(server_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        listen(server_fd, 4) < 0) {
+        close(server_fd);
+        server_fd = -1;
+        return false;
+    }
+
+    strncpy(server_path, socket_path, sizeof(server_path) - 1);
+    server_path[sizeof(server_path) - 1] = '\0';
+
+    atomic_store(&server_running, true);
+    if (pthread_create(&server_thread, NULL, metrics_server_main, NULL) != 0) {
+        atomic_store(&server_running, false);
+        close(server_fd);
+        server_fd = -1;
+        unlink(server_path);
+        return false;
+    }
+    return true;
+}
+
+// 메트릭 서버 종료
+void metrics_server_stop(void) {
+    if (!atomic_load(&server_running)) return;
+
+    atomic_store(&server_running, false);
+    pthread_join(server_thread, NULL);
+    close(server_fd);
+    server_fd = -1;
+    unlink(server_path);
+}
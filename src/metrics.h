@@ -0,0 +1,33 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "common.h"
+#include <stdint.h>
+
+// 메트릭 종류
+typedef enum {
+    METRIC_TICKS,                 // 게임 루프 틱(렌더링 프레임) 수
+    METRIC_SIM_TICKS,             // 시뮬레이션 틱 수
+    METRIC_FRAME_OVERRUNS,        // 프레임 예산(렌더링 주기)을 넘긴 틱 수
+    METRIC_RENDER_BYTES,          // 터미널로 출력한 바이트 수
+    METRIC_RENDER_BYTES_PER_SEC,  // 최근 1초간 출력 바이트 수
+    METRIC_INPUT_EVENTS,          // 처리한 입력 이벤트 수
+    METRIC_DEATHS,                // 사망 횟수
+    METRIC_CURRENT_STAGE,         // 현재 스테이지
+    METRIC_LOAD_STAGE_NS,         // 마지막 load_stage 소요 시간
+    METRIC_STAGE_PRELOAD_HITS,    // 미리 로드된 맵을 그대로 쓴 스테이지 전환 수
+    METRIC_RESPAWN_NS,            // 마지막 리스폰(맵 복원) 소요 시간
+    METRIC_RANKING_SAVE_NS,       // 마지막 랭킹 저장 소요 시간
+    METRIC_COUNT
+} MetricId;
+
+// 값 갱신/조회 (원자적 연산이라 어느 스레드에서든 잠금 없이 호출 가능)
+void metrics_add(MetricId id, uint64_t delta);
+void metrics_set(MetricId id, uint64_t value);
+uint64_t metrics_get(MetricId id);
+
+// UNIX 도메인 소켓으로 Prometheus 텍스트 형식 제공
+bool metrics_server_start(const char* socket_path);
+void metrics_server_stop(void);
+
+#endif // METRICS_H
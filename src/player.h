@@ -25,12 +25,16 @@ typedef struct Player {
     float vy;               // Y 속도 (중력/점프에 사용)
     PlayerState state;      // 생존/사망 상태
     bool is_on_ground;      // 지상에 있는지 (점프/이동에 사용)
+    bool last_jump;         // 직전 틱의 점프 입력 (누른 순간에만 점프)
+    float vx_accumulator;   // 수평 이동 누적 (1타일 이상 쌓이면 이동)
+    float vy_accumulator;   // 수직 이동 누적
 } Player;
 
 // 함수 선언
 void player_init(Player* player, PlayerType type, int start_x, int start_y);
 void player_update(Player* player, Map* map, bool left_pressed, bool right_pressed, bool jump_pressed, float delta_time);
 void player_reset(Player* player, int start_x, int start_y);
+bool player_is_at_rest(const Player* player); // 지상에 멈춰 있는지 확인
 
 // 보석 카운트 조회
 int player_get_fire_gem_count(void);
@@ -0,0 +1,215 @@
+#include "profiler.h"
+#include "console.h"
+#include "trace.h"
+
+// HDR 방식 로그-선형 히스토그램
+// 2의 거듭제곱 구간마다 16개의 하위 버킷으로 나눠 상대 오차를 약 6% 이내로 유지
+#define PROF_SUB_BITS 4
+#define PROF_SUB_COUNT (1 << PROF_SUB_BITS)
+#define PROF_BUCKET_COUNT ((64 - PROF_SUB_BITS + 1) * PROF_SUB_COUNT)
+
+typedef struct {
+    uint32_t buckets[PROF_BUCKET_COUNT];
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+} PhaseHistogram;
+
+static PhaseHistogram histograms[PROF_PHASE_COUNT];
+static uint64_t phase_start_ns[PROF_PHASE_COUNT];
+static bool overlay_visible = false;
+
+static const char* phase_names[PROF_PHASE_COUNT] = {
+    "input_update",
+    "map_update_boxes",
+    "map_update_switches",
+    "map_update_platforms",
+    "map_update_toggle_platforms",
+    "map_update_vertical_walls",
+    "player_update(fireboy)",
+    "player_update(watergirl)",
+    "render",
+    "flush"
+};
+
+// 값 -> 버킷 인덱스
+static int bucket_index(uint64_t value) {
+    if (value < PROF_SUB_COUNT) {
+        return (int)value;
+    }
+    int msb = 63 - __builtin_clzll(value);
+    int shift = msb - PROF_SUB_BITS;
+    int sub = (int)((value >> shift) & (PROF_SUB_COUNT - 1));
+    return (shift + 1) * PROF_SUB_COUNT + sub;
+}
+
+// 버킷 인덱스 -> 버킷 하한값
+static uint64_t bucket_lower_bound(int index) {
+    if (index < PROF_SUB_COUNT) {
+        return (uint64_t)index;
+    }
+    int shift = index / PROF_SUB_COUNT - 1;
+    int sub = index % PROF_SUB_COUNT;
+    return (uint64_t)(PROF_SUB_COUNT + sub) << shift;
+}
+
+// 버킷 인덱스 -> 버킷 상한값 (다음 버킷 하한 - 1)
+static uint64_t bucket_upper_bound(int index) {
+    if (index + 1 >= PROF_BUCKET_COUNT) {
+        return UINT64_MAX;
+    }
+    return bucket_lower_bound(index + 1) - 1;
+}
+
+// 프로파일러 초기화
+void profiler_init(void) {
+    memset(histograms, 0, sizeof(histograms));
+    for (int i = 0; i < PROF_PHASE_COUNT; i++) {
+        histograms[i].min_ns = UINT64_MAX;
+        phase_start_ns[i] = 0;
+    }
+    overlay_visible = false;
+}
+
+// 단조 시계 (가능하면 NTP 보정이 없는 RAW 시계 사용)
+uint64_t profiler_now_ns(void) {
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC_RAW
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 단계 시작/끝 (트레이스 모드면 같은 구간을 트레이스 span으로도 기록)
+void profiler_begin(ProfilePhase phase) {
+    trace_begin(phase_names[phase]);
+    phase_start_ns[phase] = profiler_now_ns();
+}
+
+void profiler_end(ProfilePhase phase) {
+    profiler_record(phase, profiler_now_ns() - phase_start_ns[phase]);
+    trace_end(phase_names[phase]);
+}
+
+// 측정값 하나를 히스토그램에 기록
+void profiler_record(ProfilePhase phase, uint64_t elapsed_ns) {
+    PhaseHistogram* h = &histograms[phase];
+    h->buckets[bucket_index(elapsed_ns)]++;
+    h->count++;
+    h->total_ns += elapsed_ns;
+    if (elapsed_ns < h->min_ns) h->min_ns = elapsed_ns;
+    if (elapsed_ns > h->max_ns) h->max_ns = elapsed_ns;
+}
+
+const char* profiler_phase_name(ProfilePhase phase) {
+    if (phase < 0 || phase >= PROF_PHASE_COUNT) return "?";
+    return phase_names[phase];
+}
+
+// 백분위수 계산 (해당 버킷의 상한값 반환, 최대값으로 클램프)
+uint64_t profiler_percentile(ProfilePhase phase, double percentile) {
+    const PhaseHistogram* h = &histograms[phase];
+    if (h->count == 0) return 0;
+
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)h->count + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > h->count) rank = h->count;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < PROF_BUCKET_COUNT; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            uint64_t upper = bucket_upper_bound(i);
+            return upper < h->max_ns ? upper : h->max_ns;
+        }
+    }
+    return h->max_ns;
+}
+
+void profiler_toggle_overlay(void) {
+    overlay_visible = !overlay_visible;
+}
+
+bool profiler_is_overlay_visible(void) {
+    return overlay_visible;
+}
+
+// 단계별 p50/p99 오버레이 그리기 (마이크로초 단위)
+void profiler_draw_overlay(int screen_x, int screen_y) {
+    console_set_cursor_position(screen_x, screen_y);
+    console_set_color(COLOR_BLACK, COLOR_CYAN);
+    printf(" %-28s %8s %8s ", "phase", "p50(us)", "p99(us)");
+
+    for (int i = 0; i < PROF_PHASE_COUNT; i++) {
+        console_set_cursor_position(screen_x, screen_y + 1 + i);
+        console_set_color(COLOR_WHITE, COLOR_BLACK);
+        printf(" %-28s %8.1f %8.1f ", phase_names[i],
+               profiler_percentile((ProfilePhase)i, 50.0) / 1000.0,
+               profiler_percentile((ProfilePhase)i, 99.0) / 1000.0);
+    }
+    console_reset_color();
+}
+
+// 전체 히스토그램을 파일로 저장 (기록된 버킷만)
+bool profiler_dump(const char* filename) {
+    if (!filename) return false;
+
+    FILE* file = fopen(filename, "w");
+    if (!file) return false;
+
+    for (int p = 0; p < PROF_PHASE_COUNT; p++) {
+        const PhaseHistogram* h = &histograms[p];
+        fprintf(file, "# phase %s\n", phase_names[p]);
+        if (h->count == 0) {
+            fprintf(file, "count 0\n\n");
+            continue;
+        }
+        fprintf(file, "count %llu min_ns %llu p50_ns %llu p90_ns %llu p99_ns %llu p999_ns %llu max_ns %llu mean_ns %llu\n",
+                (unsigned long long)h->count,
+                (unsigned long long)h->min_ns,
+                (unsigned long long)profiler_percentile((ProfilePhase)p, 50.0),
+                (unsigned long long)profiler_percentile((ProfilePhase)p, 90.0),
+                (unsigned long long)profiler_percentile((ProfilePhase)p, 99.0),
+                (unsigned long long)profiler_percentile((ProfilePhase)p, 99.9),
+                (unsigned long long)h->max_ns,
+                (unsigned long long)(h->total_ns / h->count));
+        fprintf(file, "# lower_ns upper_ns count cumulative\n");
+
+        uint64_t seen = 0;
+        for (int i = 0; i < PROF_BUCKET_COUNT; i++) {
+            if (h->buckets[i] == 0) continue;
+            seen += h->buckets[i];
+            fprintf(file, "%llu %llu %u %.6f\n",
+                    (unsigned long long)bucket_lower_bound(i),
+                    (unsigned long long)bucket_upper_bound(i),
+                    h->buckets[i],
+                    (double)seen / (double)h->count);
+        }
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    return true;
+}
+
+// 기록이 있는 단계만 한 줄씩 요약 출력 (나노초 단위)
+void profiler_print_summary(FILE* out) {
+    if (!out) return;
+
+    fprintf(out, "%-28s %10s %10s %10s %10s %10s\n",
+            "phase", "count", "mean_ns", "p50_ns", "p99_ns", "max_ns");
+    for (int p = 0; p < PROF_PHASE_COUNT; p++) {
+        const PhaseHistogram* h = &histograms[p];
+        if (h->count == 0) continue;
+        fprintf(out, "%-28s %10llu %10llu %10llu %10llu %10llu\n",
+                phase_names[p],
+                (unsigned long long)h->count,
+                (unsigned long long)(h->total_ns / h->count),
+                (unsigned long long)profiler_percentile((ProfilePhase)p, 50.0),
+                (unsigned long long)profiler_percentile((ProfilePhase)p, 99.0),
+                (unsigned long long)h->max_ns);
+    }
+}
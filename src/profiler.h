@@ -0,0 +1,42 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "common.h"
+#include <stdint.h>
+
+// 게임 루프 프레임 단계
+typedef enum {
+    PROF_INPUT,              // input_update
+    PROF_BOXES,              // map_update_boxes
+    PROF_SWITCHES,           // map_update_switches
+    PROF_PLATFORMS,          // map_update_platforms
+    PROF_TOGGLE_PLATFORMS,   // map_update_toggle_platforms
+    PROF_VERTICAL_WALLS,     // map_update_vertical_walls
+    PROF_FIREBOY,            // player_update (Fireboy)
+    PROF_WATERGIRL,          // player_update (Watergirl)
+    PROF_RENDER,             // 맵/플레이어/HUD 렌더링
+    PROF_FLUSH,              // stdout 플러시
+    PROF_PHASE_COUNT
+} ProfilePhase;
+
+// 함수 선언
+void profiler_init(void);
+uint64_t profiler_now_ns(void); // 단조 시계 (나노초)
+void profiler_begin(ProfilePhase phase);
+void profiler_end(ProfilePhase phase);
+void profiler_record(ProfilePhase phase, uint64_t elapsed_ns);
+const char* profiler_phase_name(ProfilePhase phase);
+uint64_t profiler_percentile(ProfilePhase phase, double percentile); // 나노초 (기록 없으면 0)
+
+// 오버레이 (디버그 키로 토글)
+void profiler_toggle_overlay(void);
+bool profiler_is_overlay_visible(void);
+void profiler_draw_overlay(int screen_x, int screen_y);
+
+// 전체 히스토그램을 파일로 저장
+bool profiler_dump(const char* filename);
+
+// 기록이 있는 단계만 한 줄씩 요약 출력 (횟수, 평균, p50, p99, 최대)
+void profiler_print_summary(FILE* out);
+
+#endif // PROFILER_H
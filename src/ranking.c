@@ -100,7 +100,7 @@ void ranking_display(const RankingSystem* system) {
     
     // 헤더
     console_set_color(COLOR_CYAN, COLOR_BLACK);
-    printf("     순위   이름              시간      사망   \n");
+    printf("     순위   이름              시간        사망   \n");
     printf("     ────────────────────────────────────────\n");
     console_reset_color();
     
@@ -109,8 +109,11 @@ void ranking_display(const RankingSystem* system) {
         printf("\n           아직 기록이 없습니다!\n");
     } else {
         for (int i = 0; i < system->count; i++) {
-            int minutes = (int)(system->entries[i].clear_time / 60.0f);
-            int seconds = (int)(system->entries[i].clear_time) % 60;
+            // 밀리초 단위로 반올림해서 분:초.밀리초로 표시
+            long total_ms = (long)(system->entries[i].clear_time * 1000.0f + 0.5f);
+            int minutes = (int)(total_ms / 60000);
+            int seconds = (int)(total_ms / 1000 % 60);
+            int millis = (int)(total_ms % 1000);
             
             // 순위에 따라 색상 다르게
             if (i == 0) {
@@ -128,9 +131,9 @@ void ranking_display(const RankingSystem* system) {
                 printf("     %2d ", i + 1);
             }
             
-            printf("  %-16s  %2d:%02d    %3d회\n", 
+            printf("  %-16s  %2d:%02d.%03d  %3d회\n", 
                    system->entries[i].name,
-                   minutes, seconds,
+                   minutes, seconds, millis,
                    system->entries[i].deaths);
             console_reset_color();
         }
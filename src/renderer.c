@@ -15,6 +15,14 @@ static bool prev_platform_valid[MAX_PLATFORMS];
 static int prev_toggle_platform_y[MAX_PLATFORMS];
 static bool prev_toggle_platform_valid[MAX_PLATFORMS];
 
+// 발판 보간 비율 (0 = 직전 시뮬레이션 상태, 1 = 최신 상태)
+static float interpolation_alpha = 1.0f;
+
+// 직전/최신 시뮬레이션 위치 사이를 보간
+static float interpolate(float prev, float current) {
+    return prev + (current - prev) * interpolation_alpha;
+}
+
 // 렌더러 초기화
 void renderer_init(int width, int height) {
     screen_width = width;
@@ -63,6 +71,13 @@ void renderer_reset(void) {
     }
 }
 
+// 발판 보간 비율 설정 (시뮬레이션 틱 사이에서 몇 % 지점을 그릴지)
+void renderer_set_interpolation(float alpha) {
+    if (alpha < 0.0f) alpha = 0.0f;
+    if (alpha > 1.0f) alpha = 1.0f;
+    interpolation_alpha = alpha;
+}
+
 // 타일을 화면에 렌더링 (유니코드 문자 + 배경색 사용, 타일당 2칸)
 // map과 map_x, map_y를 전달하면 스위치/도어 상태를 확인하여 색상 변경
 void render_tile(TileType tile, int x, int y) {
@@ -348,7 +363,7 @@ void render_map_no_flicker_with_players(const Map* map, int camera_x, int camera
             int px = map->toggle_platforms[i].x;
             int width = map->toggle_platforms[i].width;
             int old_py = prev_toggle_platform_y[i];
-            int new_py = (int)roundf(map->toggle_platforms[i].y);
+            int new_py = (int)roundf(interpolate(map->toggle_platforms[i].prev_y, map->toggle_platforms[i].y));
             
             // 위치가 바뀌었으면 이전 위치 지우기
             if (old_py != new_py) {
@@ -367,7 +382,7 @@ void render_map_no_flicker_with_players(const Map* map, int camera_x, int camera
         // 2단계: 현재 위치에 그리기
         for (int i = 0; i < map->toggle_platform_count; i++) {
             int px = map->toggle_platforms[i].x;
-            int py = (int)roundf(map->toggle_platforms[i].y);
+            int py = (int)roundf(interpolate(map->toggle_platforms[i].prev_y, map->toggle_platforms[i].y));
             int width = map->toggle_platforms[i].width;
             
             for (int w = 0; w < width; w++) {
@@ -400,8 +415,8 @@ void render_map_no_flicker_with_players(const Map* map, int camera_x, int camera
             int old_sy = old_py - camera_y;
             
             // 현재 위치와 다른 경우에만 이전 위치를 지움
-            int new_px = map->platforms[i].active ? (int)roundf(map->platforms[i].x) : -1;
-            int new_py = map->platforms[i].active ? (int)roundf(map->platforms[i].y) : -1;
+            int new_px = map->platforms[i].active ? (int)roundf(interpolate(map->platforms[i].prev_x, map->platforms[i].x)) : -1;
+            int new_py = map->platforms[i].active ? (int)roundf(interpolate(map->platforms[i].prev_y, map->platforms[i].y)) : -1;
             
             if (old_px != new_px || old_py != new_py) {
                 if (old_sx >= 0 && old_sx < tiles_per_row && old_sy >= 0 && old_sy < screen_height - 1) {
@@ -419,8 +434,8 @@ void render_map_no_flicker_with_players(const Map* map, int camera_x, int camera
                 continue;
             }
             
-            int px = (int)roundf(map->platforms[i].x);
-            int py = (int)roundf(map->platforms[i].y);
+            int px = (int)roundf(interpolate(map->platforms[i].prev_x, map->platforms[i].x));
+            int py = (int)roundf(interpolate(map->platforms[i].prev_y, map->platforms[i].y));
             int sx = px - camera_x;
             int sy = py - camera_y;
             
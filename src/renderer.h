@@ -10,6 +10,7 @@
 void renderer_init(int screen_width, int screen_height);
 void renderer_cleanup(void);
 void renderer_reset(void); // 렌더러 리셋 (사망 후 화면 다시 그리기용)
+void renderer_set_interpolation(float alpha); // 발판을 직전/최신 시뮬레이션 상태 사이 어디에 그릴지 (0~1)
 void render_map(const Map* map, int camera_x, int camera_y);
 void render_tile(TileType tile, int x, int y);
 void render_tile_with_map(TileType tile, int screen_x, int screen_y, const Map* map, int map_x, int map_y);
@@ -0,0 +1,213 @@
+#include "replay.h"
+
+// 빌드 식별 문자열 (빌드 시 -DBUILD_ID="..."로 지정 가능)
+#ifndef BUILD_ID
+#define BUILD_ID __DATE__ " " __TIME__
+#endif
+
+// 틱 입력 비트 (시뮬레이션이 쓰는 키만 저장, 위 키는 점프와 같음)
+#define REPLAY_FIRE_LEFT   0x01
+#define REPLAY_FIRE_RIGHT  0x02
+#define REPLAY_FIRE_JUMP   0x04
+#define REPLAY_WATER_LEFT  0x08
+#define REPLAY_WATER_RIGHT 0x10
+#define REPLAY_WATER_JUMP  0x20
+
+// 기록 상태
+static FILE* record_file = NULL;
+static uint8_t record_prev = 0;    // 마지막으로 파일에 쓴 입력
+static uint8_t record_value = 0;   // 아직 쓰지 않은 구간의 입력
+static uint32_t record_run = 0;    // 아직 쓰지 않은 구간의 틱 수
+
+// 재생 상태
+static FILE* play_file = NULL;
+static uint8_t play_value = 0;
+static uint32_t play_run = 0;      // 현재 구간에서 남은 틱 수
+
+uint64_t replay_build_hash(void) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char* p = BUILD_ID; *p; p++) {
+        hash ^= (uint64_t)(unsigned char)*p;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static uint8_t pack_input(const PlayerInput* input) {
+    uint8_t bits = 0;
+    if (input->fireboy.left) bits |= REPLAY_FIRE_LEFT;
+    if (input->fireboy.right) bits |= REPLAY_FIRE_RIGHT;
+    if (input->fireboy.jump) bits |= REPLAY_FIRE_JUMP;
+    if (input->watergirl.left) bits |= REPLAY_WATER_LEFT;
+    if (input->watergirl.right) bits |= REPLAY_WATER_RIGHT;
+    if (input->watergirl.jump) bits |= REPLAY_WATER_JUMP;
+    return bits;
+}
+
+static void unpack_input(uint8_t bits, PlayerInput* input) {
+    memset(input, 0, sizeof(PlayerInput));
+    input->fireboy.left = (bits & REPLAY_FIRE_LEFT) != 0;
+    input->fireboy.right = (bits & REPLAY_FIRE_RIGHT) != 0;
+    input->fireboy.jump = (bits & REPLAY_FIRE_JUMP) != 0;
+    input->fireboy.up = input->fireboy.jump;
+    input->watergirl.left = (bits & REPLAY_WATER_LEFT) != 0;
+    input->watergirl.right = (bits & REPLAY_WATER_RIGHT) != 0;
+    input->watergirl.jump = (bits & REPLAY_WATER_JUMP) != 0;
+    input->watergirl.up = input->watergirl.jump;
+}
+
+// 부호 없는 LEB128
+static void write_varint(FILE* file, uint32_t value) {
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        if (value) byte |= 0x80;
+        fputc(byte, file);
+    } while (value);
+}
+
+static bool read_varint(FILE* file, uint32_t* value) {
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        int byte = fgetc(file);
+        if (byte == EOF) return false;
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// 리틀 엔디언 정수
+static void write_le(FILE* file, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        fputc((int)((value >> (i * 8)) & 0xFF), file);
+    }
+}
+
+static bool read_le(FILE* file, uint64_t* value, int bytes) {
+    uint64_t result = 0;
+    for (int i = 0; i < bytes; i++) {
+        int byte = fgetc(file);
+        if (byte == EOF) return false;
+        result |= (uint64_t)byte << (i * 8);
+    }
+    *value = result;
+    return true;
+}
+
+// 쌓아 둔 구간을 레코드 하나로 씀
+static void record_flush_run(void) {
+    if (record_run == 0) return;
+    write_varint(record_file, record_run);
+    fputc(record_value ^ record_prev, record_file);
+    record_prev = record_value;
+    record_run = 0;
+}
+
+bool replay_record_start(const char* filename, int stage_id, int tick_rate) {
+    if (record_file || !filename) return false;
+    record_file = fopen(filename, "wb");
+    if (!record_file) return false;
+
+    fwrite(REPLAY_MAGIC, 1, 4, record_file);
+    write_le(record_file, REPLAY_VERSION, 1);
+    write_le(record_file, (uint64_t)stage_id, 2);
+    write_le(record_file, (uint64_t)tick_rate, 2);
+    write_le(record_file, replay_build_hash(), 8);
+
+    record_prev = 0;
+    record_value = 0;
+    record_run = 0;
+    return true;
+}
+
+void replay_record_stage(int stage_id) {
+    if (!record_file) return;
+    record_flush_run();
+    write_varint(record_file, 0);
+    write_varint(record_file, (uint32_t)stage_id);
+    record_prev = 0;
+}
+
+void replay_record_tick(const PlayerInput* input) {
+    if (!record_file) return;
+    uint8_t value = pack_input(input);
+    if (record_run > 0 && (value != record_value || record_run == UINT32_MAX)) {
+        record_flush_run();
+    }
+    record_value = value;
+    record_run++;
+}
+
+void replay_record_stop(void) {
+    if (!record_file) return;
+    record_flush_run();
+    fclose(record_file);
+    record_file = NULL;
+}
+
+bool replay_is_recording(void) {
+    return record_file != NULL;
+}
+
+bool replay_play_start(const char* filename, ReplayHeader* header) {
+    if (play_file || !filename) return false;
+    play_file = fopen(filename, "rb");
+    if (!play_file) return false;
+
+    char magic[4];
+    uint64_t version, stage_id, tick_rate, build_hash;
+    if (fread(magic, 1, 4, play_file) != 4 || memcmp(magic, REPLAY_MAGIC, 4) != 0 ||
+        !read_le(play_file, &version, 1) || version != REPLAY_VERSION ||
+        !read_le(play_file, &stage_id, 2) ||
+        !read_le(play_file, &tick_rate, 2) ||
+        !read_le(play_file, &build_hash, 8)) {
+        fclose(play_file);
+        play_file = NULL;
+        return false;
+    }
+
+    header->stage_id = (int)stage_id;
+    header->tick_rate = (int)tick_rate;
+    header->build_hash = build_hash;
+    play_value = 0;
+    play_run = 0;
+    return true;
+}
+
+ReplayStep replay_play_next(PlayerInput* input, int* stage_id) {
+    if (!play_file) return REPLAY_END;
+
+    if (play_run == 0) {
+        uint32_t run;
+        if (!read_varint(play_file, &run)) return REPLAY_END;
+        if (run == 0) {
+            uint32_t stage;
+            if (!read_varint(play_file, &stage)) return REPLAY_END;
+            play_value = 0;
+            *stage_id = (int)stage;
+            return REPLAY_STAGE;
+        }
+        int delta = fgetc(play_file);
+        if (delta == EOF) return REPLAY_END;
+        play_value ^= (uint8_t)delta;
+        play_run = run;
+    }
+
+    play_run--;
+    unpack_input(play_value, input);
+    return REPLAY_TICK;
+}
+
+void replay_play_stop(void) {
+    if (!play_file) return;
+    fclose(play_file);
+    play_file = NULL;
+}
+
+bool replay_is_playing(void) {
+    return play_file != NULL;
+}
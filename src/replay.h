@@ -0,0 +1,44 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "common.h"
+#include "input.h"
+#include <stdint.h>
+
+// 입력 기록/재생 파일
+// 형식: 헤더("FWRP", 버전, 시작 스테이지, 틱 주기, 빌드 해시) 뒤에 레코드가 이어짐
+//   - 틱 레코드: varint 반복 횟수(>0) + 1바이트 (이전 입력과의 XOR)
+//   - 스테이지 레코드: varint 0 + varint 스테이지 번호 (이전 입력은 0으로 초기화)
+// 입력은 틱마다 거의 바뀌지 않으므로 같은 입력이 이어지는 구간은 레코드 하나로 저장됨
+#define REPLAY_MAGIC "FWRP"
+#define REPLAY_VERSION 1
+
+typedef struct {
+    int stage_id;         // 기록을 시작한 스테이지
+    int tick_rate;        // 기록 당시 시뮬레이션 주기 (Hz)
+    uint64_t build_hash;  // 기록한 빌드 (다르면 결과가 달라질 수 있음)
+} ReplayHeader;
+
+typedef enum {
+    REPLAY_TICK,   // 틱 하나의 입력
+    REPLAY_STAGE,  // 스테이지 시작
+    REPLAY_END     // 파일 끝
+} ReplayStep;
+
+// 이 빌드의 해시 (BUILD_ID 문자열의 FNV-1a)
+uint64_t replay_build_hash(void);
+
+// 기록 (세션 중 틱마다 시뮬레이션에 들어간 입력을 그대로 저장)
+bool replay_record_start(const char* filename, int stage_id, int tick_rate);
+void replay_record_stage(int stage_id);
+void replay_record_tick(const PlayerInput* input);
+void replay_record_stop(void);
+bool replay_is_recording(void);
+
+// 재생
+bool replay_play_start(const char* filename, ReplayHeader* header);
+ReplayStep replay_play_next(PlayerInput* input, int* stage_id);
+void replay_play_stop(void);
+bool replay_is_playing(void);
+
+#endif // REPLAY_H
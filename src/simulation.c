@@ -0,0 +1,31 @@
+#include "simulation.h"
+#include "profiler.h"
+
+// 게임 로직 한 틱
+void simulation_step(Map* map, Player* fireboy, Player* watergirl,
+                     const PlayerInput* input, float delta_time) {
+    // 맵 오브젝트 업데이트
+    profiler_begin(PROF_BOXES);
+    map_update_boxes(map, delta_time);
+    profiler_end(PROF_BOXES);
+    profiler_begin(PROF_SWITCHES);
+    map_update_switches(map, fireboy->x, fireboy->y, watergirl->x, watergirl->y);
+    profiler_end(PROF_SWITCHES);
+    profiler_begin(PROF_PLATFORMS);
+    map_update_platforms(map, delta_time, (struct Player*)fireboy, (struct Player*)watergirl);
+    profiler_end(PROF_PLATFORMS);
+    profiler_begin(PROF_TOGGLE_PLATFORMS);
+    map_update_toggle_platforms(map, delta_time);
+    profiler_end(PROF_TOGGLE_PLATFORMS);
+    profiler_begin(PROF_VERTICAL_WALLS);
+    map_update_vertical_walls(map, delta_time);
+    profiler_end(PROF_VERTICAL_WALLS);
+    
+    // 플레이어 업데이트 (물리 시스템 포함)
+    profiler_begin(PROF_FIREBOY);
+    player_update(fireboy, map, input->fireboy.left, input->fireboy.right, input->fireboy.jump, delta_time);
+    profiler_end(PROF_FIREBOY);
+    profiler_begin(PROF_WATERGIRL);
+    player_update(watergirl, map, input->watergirl.left, input->watergirl.right, input->watergirl.jump, delta_time);
+    profiler_end(PROF_WATERGIRL);
+}
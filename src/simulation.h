@@ -0,0 +1,13 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "common.h"
+#include "map.h"
+#include "player.h"
+#include "input.h"
+
+// 게임 로직 한 틱 (맵 오브젝트 → 플레이어 순서, 단계별로 프로파일러에 기록)
+void simulation_step(Map* map, Player* fireboy, Player* watergirl,
+                     const PlayerInput* input, float delta_time);
+
+#endif // SIMULATION_H
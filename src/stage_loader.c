@@ -0,0 +1,115 @@
+#include "stage_loader.h"
+#include <stdatomic.h>
+#include <pthread.h>
+
+// 스테이지별 준비된 맵 슬롯
+// 로더 스레드는 교체(exchange)로 넣고, 게임 루프는 교체로 꺼내므로
+// 꺼낸 맵은 항상 한쪽만 소유함
+static _Atomic(Map*) ready_maps[STAGE_LOADER_MAX_STAGES + 1];
+
+static pthread_t loader_thread;
+static pthread_mutex_t request_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t request_cond = PTHREAD_COND_INITIALIZER;
+static int requested_stage = 0;   // 0이면 요청 없음
+static bool loader_running = false;
+
+// 스테이지 파일 경로 생성
+void stage_get_filename(int stage_id, char* buffer, size_t buffer_size) {
+    snprintf(buffer, buffer_size, "stages/stage%d.txt", stage_id);
+}
+
+// 로더 스레드: 요청이 올 때까지 자다가 맵을 파싱해 슬롯에 넣음
+static void* stage_loader_main(void* arg) {
+    (void)arg;
+    while (true) {
+        pthread_mutex_lock(&request_mutex);
+        while (loader_running && requested_stage == 0) {
+            pthread_cond_wait(&request_cond, &request_mutex);
+        }
+        if (!loader_running) {
+            pthread_mutex_unlock(&request_mutex);
+            break;
+        }
+        int stage_id = requested_stage;
+        requested_stage = 0;
+        pthread_mutex_unlock(&request_mutex);
+
+        char stage_file[256];
+        stage_get_filename(stage_id, stage_file, sizeof(stage_file));
+        // 게임 스레드가 화면을 그리는 중이므로 조용히 로드하고,
+        // 오류/경고가 있으면 버려서 전환 시 동기 로드가 게임 스레드에서 메시지를 출력하게 함
+        bool suppressed = false;
+        Map* map = map_load_from_file_quiet(stage_file, &suppressed);
+        if (map && suppressed) {
+            map_destroy(map);
+            map = NULL;
+        }
+        if (!map) continue;
+
+        // 아무도 가져가지 않은 이전 맵이 있으면 해제
+        Map* old = atomic_exchange(&ready_maps[stage_id], map);
+        if (old) {
+            map_destroy(old);
+        }
+    }
+    return NULL;
+}
+
+// 로더 스레드 시작
+bool stage_loader_start(void) {
+    pthread_mutex_lock(&request_mutex);
+    if (loader_running) {
+        pthread_mutex_unlock(&request_mutex);
+        return true;
+    }
+    loader_running = true;
+    requested_stage = 0;
+    pthread_mutex_unlock(&request_mutex);
+
+    if (pthread_create(&loader_thread, NULL, stage_loader_main, NULL) != 0) {
+        pthread_mutex_lock(&request_mutex);
+        loader_running = false;
+        pthread_mutex_unlock(&request_mutex);
+        return false;
+    }
+    return true;
+}
+
+// 로더 스레드 종료
+void stage_loader_stop(void) {
+    pthread_mutex_lock(&request_mutex);
+    if (!loader_running) {
+        pthread_mutex_unlock(&request_mutex);
+        return;
+    }
+    loader_running = false;
+    pthread_cond_signal(&request_cond);
+    pthread_mutex_unlock(&request_mutex);
+    pthread_join(loader_thread, NULL);
+
+    // 가져가지 않은 맵 정리
+    for (int i = 0; i <= STAGE_LOADER_MAX_STAGES; i++) {
+        Map* map = atomic_exchange(&ready_maps[i], NULL);
+        if (map) {
+            map_destroy(map);
+        }
+    }
+}
+
+// 백그라운드 로드 요청 (아직 처리되지 않은 이전 요청은 덮어씀)
+void stage_loader_request(int stage_id) {
+    if (stage_id < 1 || stage_id > STAGE_LOADER_MAX_STAGES) return;
+
+    pthread_mutex_lock(&request_mutex);
+    if (loader_running) {
+        requested_stage = stage_id;
+        pthread_cond_signal(&request_cond);
+    }
+    pthread_mutex_unlock(&request_mutex);
+}
+
+// 미리 로드된 맵 가져오기 (포인터 교체 한 번)
+Map* stage_loader_take(int stage_id) {
+    if (stage_id < 1 || stage_id > STAGE_LOADER_MAX_STAGES) return NULL;
+    return atomic_exchange(&ready_maps[stage_id], NULL);
+}
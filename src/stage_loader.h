@@ -0,0 +1,23 @@
+#ifndef STAGE_LOADER_H
+#define STAGE_LOADER_H
+
+#include "common.h"
+#include "map.h"
+
+// 미리 로드해 둘 수 있는 최대 스테이지 번호
+#define STAGE_LOADER_MAX_STAGES 16
+
+// 함수 선언
+bool stage_loader_start(void); // 로더 스레드 시작
+void stage_loader_stop(void);  // 로더 스레드 종료 (가져가지 않은 맵은 해제)
+
+// 스테이지 파일 경로 생성
+void stage_get_filename(int stage_id, char* buffer, size_t buffer_size);
+
+// 백그라운드 로드 요청 (스레드가 없으면 아무것도 하지 않음)
+void stage_loader_request(int stage_id);
+
+// 미리 로드된 맵 가져오기 (아직 준비되지 않았으면 NULL, 호출자가 소유권을 가짐)
+Map* stage_loader_take(int stage_id);
+
+#endif // STAGE_LOADER_H
@@ -0,0 +1,121 @@
+#include "timer.h"
+
+static unsigned split_mask = SPLIT_MASK_ALL;
+
+static const char* split_names[SPLIT_COUNT] = {
+    "first_switch",
+    "all_gems",
+    "exit"
+};
+
+// 단조 시계 (벽시계 보정의 영향을 받지 않음)
+uint64_t timer_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void timer_reset(GameTimer* timer) {
+    if (!timer) return;
+    memset(timer, 0, sizeof(GameTimer));
+}
+
+void timer_start(GameTimer* timer, uint64_t now_ns) {
+    if (!timer) return;
+    timer_reset(timer);
+    timer->resumed_ns = now_ns;
+    timer->running = true;
+}
+
+void timer_pause(GameTimer* timer, uint64_t now_ns) {
+    if (!timer || !timer->running) return;
+    timer->accumulated_ns += now_ns - timer->resumed_ns;
+    timer->running = false;
+}
+
+void timer_resume(GameTimer* timer, uint64_t now_ns) {
+    if (!timer || timer->running) return;
+    timer->resumed_ns = now_ns;
+    timer->running = true;
+}
+
+// 경과 시간 (일시정지 구간 제외)
+uint64_t timer_elapsed_ns(const GameTimer* timer, uint64_t now_ns) {
+    if (!timer) return 0;
+    if (!timer->running) return timer->accumulated_ns;
+    return timer->accumulated_ns + (now_ns - timer->resumed_ns);
+}
+
+bool timer_split(GameTimer* timer, SplitPoint point, uint64_t now_ns) {
+    if (!timer || point < 0 || point >= SPLIT_COUNT) return false;
+    if (!timer_is_split_enabled(point) || timer->split_recorded[point]) return false;
+
+    timer->splits_ns[point] = timer_elapsed_ns(timer, now_ns);
+    timer->split_recorded[point] = true;
+    return true;
+}
+
+bool timer_get_split(const GameTimer* timer, SplitPoint point, uint64_t* out_ns) {
+    if (!timer || point < 0 || point >= SPLIT_COUNT || !timer->split_recorded[point]) return false;
+    if (out_ns) *out_ns = timer->splits_ns[point];
+    return true;
+}
+
+void timer_set_split_mask(unsigned mask) {
+    split_mask = mask & SPLIT_MASK_ALL;
+}
+
+bool timer_is_split_enabled(SplitPoint point) {
+    if (point < 0 || point >= SPLIT_COUNT) return false;
+    return (split_mask & (1u << point)) != 0;
+}
+
+// 쉼표로 구분된 구간 이름 목록 파싱 ("none"이면 구간 기록 안 함)
+bool timer_parse_split_list(const char* list, unsigned* out_mask) {
+    if (!list || !out_mask) return false;
+    if (strcmp(list, "none") == 0) {
+        *out_mask = 0;
+        return true;
+    }
+
+    unsigned mask = 0;
+    const char* p = list;
+    while (*p) {
+        const char* end = strchr(p, ',');
+        size_t len = end ? (size_t)(end - p) : strlen(p);
+
+        int found = -1;
+        for (int i = 0; i < SPLIT_COUNT; i++) {
+            if (strlen(split_names[i]) == len && strncmp(p, split_names[i], len) == 0) {
+                found = i;
+                break;
+            }
+        }
+        if (found < 0) return false;
+        mask |= 1u << found;
+
+        if (!end) break;
+        p = end + 1;
+    }
+    *out_mask = mask;
+    return true;
+}
+
+const char* timer_split_name(SplitPoint point) {
+    if (point < 0 || point >= SPLIT_COUNT) return "?";
+    return split_names[point];
+}
+
+// 밀리초 단위로 표시 (1분 이상이면 분:초)
+void timer_format(uint64_t ns, char* buffer, size_t buffer_size) {
+    uint64_t total_ms = ns / 1000000ULL;
+    unsigned minutes = (unsigned)(total_ms / 60000ULL);
+    unsigned seconds = (unsigned)(total_ms / 1000ULL % 60ULL);
+    unsigned millis = (unsigned)(total_ms % 1000ULL);
+
+    if (minutes > 0) {
+        snprintf(buffer, buffer_size, "%u:%02u.%03u", minutes, seconds, millis);
+    } else {
+        snprintf(buffer, buffer_size, "%u.%03u", seconds, millis);
+    }
+}
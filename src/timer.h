@@ -0,0 +1,48 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include "common.h"
+#include <stdint.h>
+
+// 구간 기록 지점
+typedef enum {
+    SPLIT_FIRST_SWITCH,   // 첫 스위치를 누른 시점
+    SPLIT_ALL_GEMS,       // 보석을 모두 모은 시점
+    SPLIT_EXIT,           // 출구에 도착한 시점
+    SPLIT_COUNT
+} SplitPoint;
+
+#define SPLIT_MASK_ALL ((1u << SPLIT_COUNT) - 1)
+
+// 일시정지를 고려하는 스톱워치 (모든 시각은 timer_now_ns 기준 나노초)
+typedef struct {
+    uint64_t accumulated_ns;          // 마지막 일시정지까지 누적된 시간
+    uint64_t resumed_ns;              // 마지막으로 시작/재개한 시각
+    bool running;
+    uint64_t splits_ns[SPLIT_COUNT];  // 각 구간 기록 (타이머 기준 경과 시간)
+    bool split_recorded[SPLIT_COUNT];
+} GameTimer;
+
+// 함수 선언
+uint64_t timer_now_ns(void); // CLOCK_MONOTONIC (나노초)
+
+void timer_reset(GameTimer* timer);
+void timer_start(GameTimer* timer, uint64_t now_ns); // 리셋 후 시작
+void timer_pause(GameTimer* timer, uint64_t now_ns);
+void timer_resume(GameTimer* timer, uint64_t now_ns);
+uint64_t timer_elapsed_ns(const GameTimer* timer, uint64_t now_ns);
+
+// 구간 기록 (활성화된 지점이고 아직 기록되지 않았을 때만 기록하고 true 반환)
+bool timer_split(GameTimer* timer, SplitPoint point, uint64_t now_ns);
+bool timer_get_split(const GameTimer* timer, SplitPoint point, uint64_t* out_ns);
+
+// 기록할 구간 설정 (비트마스크, 기본값은 전부)
+void timer_set_split_mask(unsigned mask);
+bool timer_is_split_enabled(SplitPoint point);
+bool timer_parse_split_list(const char* list, unsigned* out_mask); // "first_switch,all_gems,exit"
+const char* timer_split_name(SplitPoint point);
+
+// 시간 문자열 ("12.345" 또는 "1:02.345")
+void timer_format(uint64_t ns, char* buffer, size_t buffer_size);
+
+#endif // TIMER_H
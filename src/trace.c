@@ -0,0 +1,99 @@
+#include "trace.h"
+#include "profiler.h"
+
+// 트레이스 이벤트 (Chrome trace event 형식의 ph 값 사용)
+typedef struct {
+    const char* name;
+    uint64_t ts_ns;
+    int value;
+    char phase; // 'B' 시작, 'E' 끝, 'i' 순간 이벤트
+} TraceEvent;
+
+static TraceEvent* events = NULL;
+static size_t event_capacity = 0;
+static size_t event_head = 0;   // 다음에 쓸 위치
+static size_t event_count = 0;  // 버퍼에 남아 있는 이벤트 수
+static uint64_t trace_start_ns = 0;
+
+// 링 버퍼 미리 할당 후 기록 시작
+bool trace_init(size_t capacity) {
+    trace_shutdown();
+    if (capacity == 0) return false;
+
+    events = (TraceEvent*)malloc(capacity * sizeof(TraceEvent));
+    if (!events) return false;
+
+    event_capacity = capacity;
+    event_head = 0;
+    event_count = 0;
+    trace_start_ns = profiler_now_ns();
+    return true;
+}
+
+void trace_shutdown(void) {
+    free(events);
+    events = NULL;
+    event_capacity = 0;
+    event_head = 0;
+    event_count = 0;
+}
+
+bool trace_is_enabled(void) {
+    return events != NULL;
+}
+
+// 이벤트 하나 기록 (버퍼가 가득 차면 가장 오래된 이벤트를 덮어씀)
+static void trace_push(const char* name, char phase, int value) {
+    if (!events) return;
+
+    TraceEvent* ev = &events[event_head];
+    ev->name = name;
+    ev->ts_ns = profiler_now_ns();
+    ev->value = value;
+    ev->phase = phase;
+
+    event_head = (event_head + 1) % event_capacity;
+    if (event_count < event_capacity) {
+        event_count++;
+    }
+}
+
+void trace_begin(const char* name) {
+    trace_push(name, 'B', 0);
+}
+
+void trace_end(const char* name) {
+    trace_push(name, 'E', 0);
+}
+
+void trace_instant(const char* name, int value) {
+    trace_push(name, 'i', value);
+}
+
+// Chrome/Perfetto trace JSON 형식으로 저장 (오래된 이벤트부터)
+bool trace_flush(const char* filename) {
+    if (!events || !filename) return false;
+
+    FILE* file = fopen(filename, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    size_t first = (event_head + event_capacity - event_count) % event_capacity;
+    for (size_t i = 0; i < event_count; i++) {
+        const TraceEvent* ev = &events[(first + i) % event_capacity];
+        // ts는 마이크로초 단위 (소수점 이하로 나노초 표현)
+        uint64_t rel_ns = ev->ts_ns >= trace_start_ns ? ev->ts_ns - trace_start_ns : 0;
+        fprintf(file, "{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu.%03llu,\"pid\":1,\"tid\":1",
+                ev->name, ev->phase,
+                (unsigned long long)(rel_ns / 1000), (unsigned long long)(rel_ns % 1000));
+        if (ev->phase == 'i') {
+            fprintf(file, ",\"s\":\"g\",\"args\":{\"value\":%d}", ev->value);
+        }
+        fprintf(file, "}%s\n", (i + 1 < event_count) ? "," : "");
+    }
+
+    fprintf(file, "]}\n");
+    fclose(file);
+    return true;
+}
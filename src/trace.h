@@ -0,0 +1,23 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "common.h"
+#include <stdint.h>
+
+// 기본 링 버퍼 크기 (이벤트 개수)
+#define TRACE_DEFAULT_CAPACITY (1 << 18)
+
+// 함수 선언
+bool trace_init(size_t capacity); // 링 버퍼 미리 할당 후 기록 시작
+void trace_shutdown(void);
+bool trace_is_enabled(void);
+
+// 이벤트 이름은 문자열 리터럴처럼 수명이 긴 문자열이어야 함 (포인터만 저장)
+void trace_begin(const char* name);
+void trace_end(const char* name);
+void trace_instant(const char* name, int value);
+
+// Chrome/Perfetto trace JSON 형식으로 저장
+bool trace_flush(const char* filename);
+
+#endif // TRACE_H
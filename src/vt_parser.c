@@ -0,0 +1,306 @@
+#include "vt_parser.h"
+
+// DFA 상태
+enum {
+    VT_STATE_GROUND,  // 일반 문자
+    VT_STATE_ESC,     // ESC를 받은 직후
+    VT_STATE_CSI,     // ESC [ 이후 파라미터 수집 중
+    VT_STATE_SS3,     // ESC O 이후
+    VT_STATE_COUNT
+};
+
+// 바이트 분류
+enum {
+    VT_CLASS_CTRL,     // C0 제어 문자, DEL
+    VT_CLASS_ESC,      // 0x1B
+    VT_CLASS_DIGIT,    // '0'-'9'
+    VT_CLASS_SEP,      // ';'
+    VT_CLASS_SUBSEP,   // ':'
+    VT_CLASS_PRIVATE,  // '<' '=' '>' '?'
+    VT_CLASS_INTER,    // 0x20-0x2F 중간 문자
+    VT_CLASS_CSI,      // '['
+    VT_CLASS_SS3,      // 'O'
+    VT_CLASS_FINAL,    // 그 밖의 0x40-0x7E
+    VT_CLASS_HIGH,     // 0x80 이상 (UTF-8 바이트)
+    VT_CLASS_COUNT
+};
+
+// 전이 동작
+enum {
+    VT_ACT_NONE,
+    VT_ACT_PRINT,         // 문자 이벤트
+    VT_ACT_ESC_START,     // 시퀀스 시작 (진행 중이던 시퀀스는 버림)
+    VT_ACT_ESC_REPEAT,    // ESC ESC: 앞의 ESC를 단독 ESC로 확정
+    VT_ACT_ALT_PRINT,     // ESC + 문자 = Alt+문자
+    VT_ACT_CSI_START,
+    VT_ACT_SS3_START,
+    VT_ACT_PARAM,
+    VT_ACT_PARAM_SEP,
+    VT_ACT_SUBPARAM_SEP,
+    VT_ACT_PRIVATE,
+    VT_ACT_CSI_DISPATCH,
+    VT_ACT_SS3_DISPATCH,
+    VT_ACT_ABORT          // 알 수 없는 시퀀스 버림
+};
+
+typedef struct {
+    uint8_t action;
+    uint8_t next;
+} VtTransition;
+
+#define T(action, next) { VT_ACT_##action, VT_STATE_##next }
+
+// 상태 x 바이트 분류 전이 표 (바인딩이 늘어나도 분기는 늘지 않음)
+static const VtTransition transitions[VT_STATE_COUNT][VT_CLASS_COUNT] = {
+    [VT_STATE_GROUND] = {
+        [VT_CLASS_CTRL] = T(PRINT, GROUND),  [VT_CLASS_ESC] = T(ESC_START, ESC),
+        [VT_CLASS_DIGIT] = T(PRINT, GROUND), [VT_CLASS_SEP] = T(PRINT, GROUND),
+        [VT_CLASS_SUBSEP] = T(PRINT, GROUND),
+        [VT_CLASS_PRIVATE] = T(PRINT, GROUND), [VT_CLASS_INTER] = T(PRINT, GROUND),
+        [VT_CLASS_CSI] = T(PRINT, GROUND),   [VT_CLASS_SS3] = T(PRINT, GROUND),
+        [VT_CLASS_FINAL] = T(PRINT, GROUND), [VT_CLASS_HIGH] = T(PRINT, GROUND)
+    },
+    [VT_STATE_ESC] = {
+        [VT_CLASS_CTRL] = T(ALT_PRINT, GROUND), [VT_CLASS_ESC] = T(ESC_REPEAT, ESC),
+        [VT_CLASS_DIGIT] = T(ALT_PRINT, GROUND), [VT_CLASS_SEP] = T(ALT_PRINT, GROUND),
+        [VT_CLASS_SUBSEP] = T(ALT_PRINT, GROUND),
+        [VT_CLASS_PRIVATE] = T(ALT_PRINT, GROUND), [VT_CLASS_INTER] = T(ALT_PRINT, GROUND),
+        [VT_CLASS_CSI] = T(CSI_START, CSI),     [VT_CLASS_SS3] = T(SS3_START, SS3),
+        [VT_CLASS_FINAL] = T(ALT_PRINT, GROUND), [VT_CLASS_HIGH] = T(ALT_PRINT, GROUND)
+    },
+    [VT_STATE_CSI] = {
+        [VT_CLASS_CTRL] = T(NONE, CSI),          [VT_CLASS_ESC] = T(ESC_START, ESC),
+        [VT_CLASS_DIGIT] = T(PARAM, CSI),        [VT_CLASS_SEP] = T(PARAM_SEP, CSI),
+        [VT_CLASS_SUBSEP] = T(SUBPARAM_SEP, CSI),
+        [VT_CLASS_PRIVATE] = T(PRIVATE, CSI),    [VT_CLASS_INTER] = T(NONE, CSI),
+        [VT_CLASS_CSI] = T(CSI_DISPATCH, GROUND), [VT_CLASS_SS3] = T(CSI_DISPATCH, GROUND),
+        [VT_CLASS_FINAL] = T(CSI_DISPATCH, GROUND), [VT_CLASS_HIGH] = T(ABORT, GROUND)
+    },
+    [VT_STATE_SS3] = {
+        [VT_CLASS_CTRL] = T(ABORT, GROUND),      [VT_CLASS_ESC] = T(ESC_START, ESC),
+        [VT_CLASS_DIGIT] = T(PARAM, SS3),        [VT_CLASS_SEP] = T(PARAM_SEP, SS3),
+        [VT_CLASS_SUBSEP] = T(SUBPARAM_SEP, SS3),
+        [VT_CLASS_PRIVATE] = T(ABORT, GROUND),   [VT_CLASS_INTER] = T(ABORT, GROUND),
+        [VT_CLASS_CSI] = T(SS3_DISPATCH, GROUND), [VT_CLASS_SS3] = T(SS3_DISPATCH, GROUND),
+        [VT_CLASS_FINAL] = T(SS3_DISPATCH, GROUND), [VT_CLASS_HIGH] = T(ABORT, GROUND)
+    }
+};
+
+#undef T
+
+// 시퀀스 → 키 표
+typedef struct {
+    unsigned char final;  // CSI/SS3 종결 문자
+    VtKey key;
+} VtFinalKey;
+
+typedef struct {
+    uint16_t number;      // CSI 번호 ~ 형식의 번호
+    VtKey key;
+} VtTildeKey;
+
+static const VtFinalKey final_key_table[] = {
+    { 'A', VT_KEY_UP },    { 'B', VT_KEY_DOWN },  { 'C', VT_KEY_RIGHT }, { 'D', VT_KEY_LEFT },
+    { 'H', VT_KEY_HOME },  { 'F', VT_KEY_END },   { 'Z', VT_KEY_BACKTAB },
+    { 'P', VT_KEY_F1 },    { 'Q', VT_KEY_F2 },    { 'R', VT_KEY_F3 },    { 'S', VT_KEY_F4 }
+};
+
+static const VtTildeKey tilde_key_table[] = {
+    { 1, VT_KEY_HOME },    { 2, VT_KEY_INSERT },  { 3, VT_KEY_DELETE },  { 4, VT_KEY_END },
+    { 5, VT_KEY_PAGE_UP }, { 6, VT_KEY_PAGE_DOWN }, { 7, VT_KEY_HOME },  { 8, VT_KEY_END },
+    { 11, VT_KEY_F1 },     { 12, VT_KEY_F2 },     { 13, VT_KEY_F3 },     { 14, VT_KEY_F4 }
+};
+
+#define VT_TILDE_LOOKUP_SIZE 32
+#define KEY_CODE_ESC 27          // "CSI 27 u": kitty 프로토콜의 ESC 키
+#define KEY_CODE_MODIFY_OTHER 27 // "CSI 27;수식;코드 ~": xterm modifyOtherKeys
+
+// 위 표에서 만든 조회 배열 (첫 사용 시 생성)
+static uint8_t byte_class[256];
+static uint8_t final_keys[128];
+static uint8_t tilde_keys[VT_TILDE_LOOKUP_SIZE];
+static bool tables_ready = false;
+
+static void vt_build_tables(void) {
+    for (int b = 0; b < 256; b++) {
+        uint8_t cls;
+        if (b == 0x1B) cls = VT_CLASS_ESC;
+        else if (b < 0x20 || b == 0x7F) cls = VT_CLASS_CTRL;
+        else if (b >= 0x80) cls = VT_CLASS_HIGH;
+        else if (b >= '0' && b <= '9') cls = VT_CLASS_DIGIT;
+        else if (b == ';') cls = VT_CLASS_SEP;
+        else if (b == ':') cls = VT_CLASS_SUBSEP;
+        else if (b >= '<' && b <= '?') cls = VT_CLASS_PRIVATE;
+        else if (b < 0x30) cls = VT_CLASS_INTER;
+        else if (b == '[') cls = VT_CLASS_CSI;
+        else if (b == 'O') cls = VT_CLASS_SS3;
+        else cls = VT_CLASS_FINAL;
+        byte_class[b] = cls;
+    }
+
+    memset(final_keys, VT_KEY_NONE, sizeof(final_keys));
+    for (size_t i = 0; i < sizeof(final_key_table) / sizeof(final_key_table[0]); i++) {
+        final_keys[final_key_table[i].final] = (uint8_t)final_key_table[i].key;
+    }
+
+    memset(tilde_keys, VT_KEY_NONE, sizeof(tilde_keys));
+    for (size_t i = 0; i < sizeof(tilde_key_table) / sizeof(tilde_key_table[0]); i++) {
+        tilde_keys[tilde_key_table[i].number] = (uint8_t)tilde_key_table[i].key;
+    }
+    tables_ready = true;
+}
+
+void vt_parser_init(VtParser* parser) {
+    if (!tables_ready) {
+        vt_build_tables();
+    }
+    memset(parser, 0, sizeof(VtParser));
+    parser->state = VT_STATE_GROUND;
+}
+
+static void vt_reset_params(VtParser* parser) {
+    parser->param_count = 0;
+    parser->sub_index = 0;
+    parser->params[0] = 0;
+    parser->subparams[0] = 0;
+    parser->private_marker = 0;
+}
+
+// 다음 ';' 파라미터 시작
+static void vt_next_param(VtParser* parser) {
+    if (parser->param_count < VT_MAX_PARAMS) {
+        parser->params[parser->param_count] = 0;
+        parser->subparams[parser->param_count] = 0;
+        parser->param_count++;
+    }
+    parser->sub_index = 0;
+}
+
+// 두 번째 파라미터를 xterm 수식키로 변환 ("1;5A" → Ctrl)
+static uint8_t vt_modifiers(const VtParser* parser) {
+    if (parser->param_count < 2 || parser->params[1] == 0) return 0;
+    return (uint8_t)((parser->params[1] - 1) & 0xFF);
+}
+
+// 수식키 파라미터의 하위 파라미터를 이벤트 종류로 변환 ("1;1:3A" → 떼기)
+static uint8_t vt_event_type(const VtParser* parser) {
+    if (parser->param_count < 2) return VT_EVENT_PRESS;
+    uint16_t type = parser->subparams[1];
+    return (type >= VT_EVENT_PRESS && type <= VT_EVENT_RELEASE) ? (uint8_t)type : VT_EVENT_PRESS;
+}
+
+static bool vt_emit(VtEvent* out, VtKey key, unsigned char ch, uint8_t modifiers) {
+    if (key == VT_KEY_NONE) return false;
+    out->key = key;
+    out->ch = ch;
+    out->modifiers = modifiers;
+    out->type = VT_EVENT_PRESS;
+    return true;
+}
+
+// 유니코드 키 코드 → 키 (kitty "CSI 코드 u", xterm modifyOtherKeys "CSI 27;수식;코드 ~")
+static bool vt_emit_codepoint(VtEvent* out, uint16_t code, uint8_t modifiers) {
+    if (code == KEY_CODE_ESC) return vt_emit(out, VT_KEY_ESCAPE, 0, modifiers);
+    if (code > 0xFF) return false; // 기능키 영역 (사용하지 않음)
+    return vt_emit(out, VT_KEY_CHAR, (unsigned char)code, modifiers);
+}
+
+// CSI 종결 처리: 방향키 등은 종결 문자로, Insert/Delete/PgUp 등은 "번호 ~"로,
+// kitty 프로토콜의 일반 키는 "코드 u"로 구분
+static bool vt_dispatch_csi(VtParser* parser, unsigned char final, VtEvent* out) {
+    bool emitted;
+    if (parser->private_marker == '?') {
+        // 터미널 질의 응답
+        if (final == 'u') return vt_emit(out, VT_KEY_REPORT_KEYBOARD_FLAGS, (unsigned char)parser->params[0], 0);
+        if (final == 'c') return vt_emit(out, VT_KEY_REPORT_DEVICE_ATTRS, 0, 0);
+        return false;
+    }
+    if (parser->private_marker != 0) return false;
+
+    if (final == 'u') {
+        emitted = vt_emit_codepoint(out, parser->params[0], vt_modifiers(parser));
+    } else if (final == '~' && parser->params[0] == KEY_CODE_MODIFY_OTHER && parser->param_count >= 3) {
+        emitted = vt_emit_codepoint(out, parser->params[2], vt_modifiers(parser));
+    } else if (final == '~') {
+        uint16_t number = parser->params[0];
+        if (number >= VT_TILDE_LOOKUP_SIZE) return false;
+        emitted = vt_emit(out, (VtKey)tilde_keys[number], 0, vt_modifiers(parser));
+    } else {
+        if (final >= 0x80) return false;
+        emitted = vt_emit(out, (VtKey)final_keys[final], 0, vt_modifiers(parser));
+    }
+    if (emitted) {
+        out->type = vt_event_type(parser);
+    }
+    return emitted;
+}
+
+// 바이트 하나 처리
+bool vt_parser_feed(VtParser* parser, unsigned char byte, uint64_t now_ns, VtEvent* out) {
+    const VtTransition* t = &transitions[parser->state][byte_class[byte]];
+    parser->state = t->next;
+
+    switch (t->action) {
+        case VT_ACT_PRINT:
+            return vt_emit(out, VT_KEY_CHAR, byte, 0);
+        case VT_ACT_ESC_START:
+            parser->pending_since_ns = now_ns;
+            return false;
+        case VT_ACT_ESC_REPEAT:
+            parser->pending_since_ns = now_ns;
+            return vt_emit(out, VT_KEY_ESCAPE, 0, 0);
+        case VT_ACT_ALT_PRINT:
+            return vt_emit(out, VT_KEY_CHAR, byte, VT_MOD_ALT);
+        case VT_ACT_CSI_START:
+        case VT_ACT_SS3_START:
+            vt_reset_params(parser);
+            return false;
+        case VT_ACT_PARAM: {
+            if (parser->param_count == 0) parser->param_count = 1;
+            if (parser->sub_index > 1) return false; // 두 번째 이후 하위 파라미터는 버림
+            size_t index = parser->param_count - 1;
+            uint16_t* param = parser->sub_index == 0 ? &parser->params[index] : &parser->subparams[index];
+            uint32_t value = (uint32_t)(*param) * 10 + (uint32_t)(byte - '0');
+            *param = value > 0xFFFF ? 0xFFFF : (uint16_t)value;
+            return false;
+        }
+        case VT_ACT_PARAM_SEP:
+            if (parser->param_count == 0) parser->param_count = 1;
+            vt_next_param(parser);
+            return false;
+        case VT_ACT_SUBPARAM_SEP:
+            if (parser->param_count == 0) parser->param_count = 1;
+            if (parser->sub_index < 0xFF) parser->sub_index++;
+            return false;
+        case VT_ACT_PRIVATE:
+            parser->private_marker = byte;
+            return false;
+        case VT_ACT_CSI_DISPATCH:
+            return vt_dispatch_csi(parser, byte, out);
+        case VT_ACT_SS3_DISPATCH:
+            if (!vt_emit(out, (VtKey)final_keys[byte & 0x7F], 0, vt_modifiers(parser))) return false;
+            out->type = vt_event_type(parser);
+            return true;
+        case VT_ACT_ABORT:
+        case VT_ACT_NONE:
+        default:
+            return false;
+    }
+}
+
+bool vt_parser_is_pending(const VtParser* parser) {
+    return parser->state != VT_STATE_GROUND;
+}
+
+// 타임아웃 확인
+bool vt_parser_poll_timeout(VtParser* parser, uint64_t now_ns, VtEvent* out) {
+    if (parser->state == VT_STATE_GROUND) return false;
+    if (now_ns - parser->pending_since_ns < VT_ESC_TIMEOUT_NS) return false;
+
+    bool was_bare_esc = parser->state == VT_STATE_ESC;
+    parser->state = VT_STATE_GROUND;
+    if (was_bare_esc) {
+        return vt_emit(out, VT_KEY_ESCAPE, 0, 0);
+    }
+    return false;
+}
@@ -0,0 +1,79 @@
+#ifndef VT_PARSER_H
+#define VT_PARSER_H
+
+#include "common.h"
+#include <stdint.h>
+
+// 해석된 키 종류
+typedef enum {
+    VT_KEY_NONE,
+    VT_KEY_CHAR,       // 일반 문자 (ch에 바이트 값)
+    VT_KEY_ESCAPE,     // ESC 단독 (타임아웃으로 확정)
+    VT_KEY_UP,
+    VT_KEY_DOWN,
+    VT_KEY_RIGHT,
+    VT_KEY_LEFT,
+    VT_KEY_HOME,
+    VT_KEY_END,
+    VT_KEY_INSERT,
+    VT_KEY_DELETE,
+    VT_KEY_PAGE_UP,
+    VT_KEY_PAGE_DOWN,
+    VT_KEY_BACKTAB,
+    VT_KEY_F1,
+    VT_KEY_F2,
+    VT_KEY_F3,
+    VT_KEY_F4,
+    VT_KEY_REPORT_KEYBOARD_FLAGS, // 터미널 응답: kitty 키보드 플래그 (CSI ? flags u)
+    VT_KEY_REPORT_DEVICE_ATTRS,   // 터미널 응답: 장치 속성 (CSI ? ... c)
+    VT_KEY_COUNT
+} VtKey;
+
+// 수식키 (xterm 방식: 파라미터 값 - 1)
+#define VT_MOD_SHIFT 0x01
+#define VT_MOD_ALT   0x02
+#define VT_MOD_CTRL  0x04
+
+// 키 이벤트 종류 (kitty 키보드 프로토콜 값과 같음, 기존 방식 입력은 항상 누름)
+typedef enum {
+    VT_EVENT_PRESS = 1,
+    VT_EVENT_REPEAT = 2,
+    VT_EVENT_RELEASE = 3
+} VtEventType;
+
+typedef struct {
+    VtKey key;
+    unsigned char ch;   // VT_KEY_CHAR일 때 문자
+    uint8_t modifiers;
+    uint8_t type;       // VtEventType
+} VtEvent;
+
+#define VT_MAX_PARAMS 4
+
+// 파서 상태 (입력 호출 사이에 유지되므로 잘려서 들어온 시퀀스도 이어서 해석)
+typedef struct {
+    uint8_t state;
+    uint8_t param_count;
+    uint8_t sub_index;            // 현재 파라미터 안의 ':' 하위 파라미터 위치
+    uint16_t params[VT_MAX_PARAMS];
+    uint16_t subparams[VT_MAX_PARAMS]; // 각 파라미터의 첫 번째 하위 파라미터 (수식키 뒤의 이벤트 종류 등)
+    unsigned char private_marker; // CSI 뒤의 '<', '=', '>', '?'
+    uint64_t pending_since_ns;    // 시퀀스를 시작한 시각 (ESC 타임아웃 판정용)
+} VtParser;
+
+// 단독 ESC로 확정하기까지 기다리는 시간
+#define VT_ESC_TIMEOUT_NS 50000000ULL
+
+// 함수 선언
+void vt_parser_init(VtParser* parser);
+
+// 바이트 하나 입력 (이벤트가 완성되면 out에 채우고 true)
+bool vt_parser_feed(VtParser* parser, unsigned char byte, uint64_t now_ns, VtEvent* out);
+
+// 시퀀스 도중에 멈춰 있는지 (다음 바이트를 기다리는 중)
+bool vt_parser_is_pending(const VtParser* parser);
+
+// 타임아웃이 지나면 보류 중인 ESC를 단독 ESC로 확정 (불완전한 CSI/SS3는 버림)
+bool vt_parser_poll_timeout(VtParser* parser, uint64_t now_ns, VtEvent* out);
+
+#endif // VT_PARSER_H
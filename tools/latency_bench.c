@@ -0,0 +1,325 @@
+// 입력 → 화면 지연 벤치마크
+// 게임을 가상 터미널(PTY)에서 실행하고 방향키를 보낸 시각부터 Fireboy 글리프(☻)가
+// 다른 칸에 그려질 때까지의 시간을 잰다. 출력 스트림의 커서 이동만 따라가는 최소한의
+// 화면 모델을 사용한다.
+#define _XOPEN_SOURCE 700
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+
+#define DEFAULT_SAMPLES 100
+#define DEFAULT_HOLD_MS 2000
+#define SCREEN_COLS 80
+#define SCREEN_ROWS 30
+#define SETTLE_MS 500       // 화면이 이만큼 조용하면 준비된 것으로 봄
+#define QUIET_MS 200        // 샘플 사이 대기 (키 떼기 추정 100ms + 여유)
+#define MOVE_TIMEOUT_MS 1000 // 이 시간 안에 움직이지 않으면 막힌 것으로 보고 방향을 바꿈
+#define JITTER_MS 50        // 프레임 경계에 맞물리지 않도록 샘플 간격에 더하는 무작위 지연
+#define HOLD_REPEAT_MS 30   // 누르고 있기 단계의 키 반복 간격
+
+static const char* KEY_RIGHT = "\033[C";
+static const char* KEY_LEFT = "\033[D";
+
+// 출력 스트림 해석 상태
+typedef struct {
+    int row, col;               // 커서 위치 (1부터)
+    int esc_state;              // 0: 일반, 1: ESC 받음, 2: CSI 파라미터
+    int params[2];
+    int param_count;
+    unsigned char utf8[4];
+    int utf8_len, utf8_need;
+    int fire_row, fire_col;     // 마지막으로 ☻가 그려진 위치
+    uint64_t fire_moved_ns;     // 마지막으로 위치가 바뀐 시각
+    uint64_t bytes;             // 받은 출력 바이트 수
+} Screen;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 문자 하나가 그려짐
+static void screen_put(Screen* s, const unsigned char* ch, int len, uint64_t t) {
+    // ☻ (U+263B) = E2 98 BB
+    if (len == 3 && ch[0] == 0xE2 && ch[1] == 0x98 && ch[2] == 0xBB) {
+        if (s->row != s->fire_row || s->col != s->fire_col) {
+            s->fire_row = s->row;
+            s->fire_col = s->col;
+            s->fire_moved_ns = t;
+        }
+    }
+    s->col++;
+}
+
+static void screen_feed(Screen* s, const unsigned char* data, size_t n, uint64_t t) {
+    s->bytes += n;
+    for (size_t i = 0; i < n; i++) {
+        unsigned char b = data[i];
+        if (s->esc_state == 1) {
+            if (b == '[') {
+                s->esc_state = 2;
+                s->param_count = 0;
+                s->params[0] = s->params[1] = 0;
+            } else {
+                s->esc_state = 0;
+            }
+            continue;
+        }
+        if (s->esc_state == 2) {
+            if (b >= '0' && b <= '9') {
+                if (s->param_count == 0) s->param_count = 1;
+                if (s->param_count <= 2) {
+                    s->params[s->param_count - 1] = s->params[s->param_count - 1] * 10 + (b - '0');
+                }
+            } else if (b == ';') {
+                if (s->param_count == 0) s->param_count = 1;
+                s->param_count++;
+                if (s->param_count <= 2) s->params[s->param_count - 1] = 0;
+            } else if (b >= 0x40 && b <= 0x7E) {
+                if (b == 'H' || b == 'f') {
+                    s->row = s->params[0] > 0 ? s->params[0] : 1;
+                    s->col = (s->param_count >= 2 && s->params[1] > 0) ? s->params[1] : 1;
+                }
+                s->esc_state = 0;
+            }
+            continue;
+        }
+        if (s->utf8_need > 0) {
+            s->utf8[s->utf8_len++] = b;
+            if (s->utf8_len == s->utf8_need) {
+                screen_put(s, s->utf8, s->utf8_len, t);
+                s->utf8_need = 0;
+            }
+            continue;
+        }
+        if (b == 0x1B) {
+            s->esc_state = 1;
+        } else if (b == '\r') {
+            s->col = 1;
+        } else if (b == '\n') {
+            s->row++;
+        } else if (b >= 0xC0) {
+            s->utf8[0] = b;
+            s->utf8_len = 1;
+            s->utf8_need = b >= 0xF0 ? 4 : (b >= 0xE0 ? 3 : 2);
+        } else if (b >= 0x20 && b < 0x7F) {
+            screen_put(s, &b, 1, t);
+        }
+    }
+}
+
+// PTY에서 읽을 수 있는 만큼 읽음 (timeout_ms 동안 기다림, 자식이 끝나면 false)
+static bool pump(int fd, Screen* s, int timeout_ms) {
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    if (poll(&pfd, 1, timeout_ms) <= 0) return true;
+    unsigned char buffer[65536];
+    ssize_t n = read(fd, buffer, sizeof(buffer));
+    if (n <= 0) return false;
+    screen_feed(s, buffer, (size_t)n, now_ns());
+    return true;
+}
+
+// 주어진 시간 동안 계속 읽음
+static bool pump_for(int fd, Screen* s, int ms) {
+    uint64_t end = now_ns() + (uint64_t)ms * 1000000ULL;
+    while (now_ns() < end) {
+        int left = (int)((end - now_ns()) / 1000000ULL);
+        if (!pump(fd, s, left > 0 ? left : 1)) return false;
+    }
+    return true;
+}
+
+// ☻가 quiet_ms 동안 움직이지 않을 때까지 대기
+static bool wait_quiet(int fd, Screen* s, int quiet_ms, int limit_ms) {
+    uint64_t limit = now_ns() + (uint64_t)limit_ms * 1000000ULL;
+    while (now_ns() < limit) {
+        if (!pump(fd, s, 10)) return false;
+        uint64_t t = now_ns();
+        if (s->fire_row > 0 && t - s->fire_moved_ns >= (uint64_t)quiet_ms * 1000000ULL) return true;
+    }
+    return s->fire_row > 0;
+}
+
+static void send_keys(int fd, const char* keys) {
+    ssize_t written = write(fd, keys, strlen(keys));
+    (void)written;
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static double percentile_ms(const uint64_t* sorted, int count, double p) {
+    int rank = (int)(p / 100.0 * count + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1] / 1e6;
+}
+
+// 게임을 PTY 슬레이브에 연결해서 실행
+static pid_t spawn_game(char* const argv[], int* master_fd) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0) return -1;
+    const char* slave_name = ptsname(master);
+    if (!slave_name) return -1;
+
+    pid_t pid = fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        setsid();
+        int slave = open(slave_name, O_RDWR);
+        if (slave < 0) _exit(127);
+        struct winsize ws = { SCREEN_ROWS, SCREEN_COLS, 0, 0 };
+        ioctl(slave, TIOCSWINSZ, &ws);
+        ioctl(slave, TIOCSCTTY, 0);
+        dup2(slave, STDIN_FILENO);
+        dup2(slave, STDOUT_FILENO);
+        dup2(slave, STDERR_FILENO);
+        if (slave > STDERR_FILENO) close(slave);
+        close(master);
+        setenv("TERM", "xterm", 1);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    *master_fd = master;
+    return pid;
+}
+
+static void print_usage(const char* program) {
+    printf("사용법: %s [--samples N] [--hold-ms MS] [게임 경로 [게임 인자...]]\n", program);
+    printf("  --samples N    지연 측정 횟수 (기본 %d)\n", DEFAULT_SAMPLES);
+    printf("  --hold-ms MS   키를 누르고 있는 동안의 출력량 측정 시간 (기본 %d)\n", DEFAULT_HOLD_MS);
+}
+
+int main(int argc, char* argv[]) {
+    int samples = DEFAULT_SAMPLES;
+    int hold_ms = DEFAULT_HOLD_MS;
+    char* default_game[] = { "./fireboy_watergirl", NULL };
+    char** game_argv = default_game;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--hold-ms") == 0 && i + 1 < argc) {
+            hold_ms = atoi(argv[++i]);
+        } else if (argv[i][0] != '-') {
+            game_argv = &argv[i];
+            break;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (samples <= 0) samples = DEFAULT_SAMPLES;
+
+    int fd;
+    pid_t pid = spawn_game(game_argv, &fd);
+    if (pid < 0) {
+        fprintf(stderr, "PTY에서 게임을 실행할 수 없습니다: %s\n", game_argv[0]);
+        return 1;
+    }
+
+    Screen screen;
+    memset(&screen, 0, sizeof(screen));
+    screen.row = screen.col = 1;
+
+    // 메뉴 통과: 게임하기 → 이름 입력 → 시작
+    pump_for(fd, &screen, 500);
+    send_keys(fd, "\n");
+    pump_for(fd, &screen, 500);
+    send_keys(fd, "latency\n");
+    pump_for(fd, &screen, 800);
+    send_keys(fd, "\n");
+    if (!wait_quiet(fd, &screen, SETTLE_MS, 5000)) {
+        fprintf(stderr, "게임 화면에서 Fireboy를 찾지 못했습니다\n");
+        kill(pid, SIGTERM);
+        waitpid(pid, NULL, 0);
+        return 1;
+    }
+
+    // 지연 측정: 방향키 한 번 → ☻가 다른 칸에 그려질 때까지
+    uint64_t* latencies = malloc(sizeof(uint64_t) * (size_t)samples);
+    if (!latencies) return 1;
+    int measured = 0;
+    int timeouts = 0;
+    bool right = true;
+    srand(1);
+
+    uint64_t sample_start_ns = now_ns();
+    uint64_t sample_start_bytes = screen.bytes;
+    for (int i = 0; i < samples; i++) {
+        if (!pump_for(fd, &screen, rand() % (JITTER_MS + 1))) break;
+
+        int row = screen.fire_row, col = screen.fire_col;
+        uint64_t sent_ns = now_ns();
+        send_keys(fd, right ? KEY_RIGHT : KEY_LEFT);
+
+        bool moved = false;
+        uint64_t deadline = sent_ns + (uint64_t)MOVE_TIMEOUT_MS * 1000000ULL;
+        while (now_ns() < deadline) {
+            if (!pump(fd, &screen, 5)) break;
+            if (screen.fire_row != row || screen.fire_col != col) {
+                latencies[measured++] = screen.fire_moved_ns - sent_ns;
+                moved = true;
+                break;
+            }
+        }
+        if (!moved) {
+            timeouts++;
+        }
+        right = !right; // 좌우를 번갈아 제자리 근처에 머묾
+        if (!wait_quiet(fd, &screen, QUIET_MS, 2000)) break;
+    }
+    uint64_t sample_ns = now_ns() - sample_start_ns;
+    uint64_t sample_bytes = screen.bytes - sample_start_bytes;
+
+    // 지속 출력량: 키를 계속 누르고 있는 동안 (절반씩 좌우)
+    uint64_t hold_start_ns = now_ns();
+    uint64_t hold_start_bytes = screen.bytes;
+    uint64_t hold_end_ns = hold_start_ns + (uint64_t)hold_ms * 1000000ULL;
+    uint64_t half_ns = hold_start_ns + (uint64_t)hold_ms * 500000ULL;
+    while (now_ns() < hold_end_ns) {
+        send_keys(fd, now_ns() < half_ns ? KEY_RIGHT : KEY_LEFT);
+        if (!pump_for(fd, &screen, HOLD_REPEAT_MS)) break;
+    }
+    uint64_t hold_ns = now_ns() - hold_start_ns;
+    uint64_t hold_bytes = screen.bytes - hold_start_bytes;
+
+    // 종료
+    send_keys(fd, "\033");
+    pump_for(fd, &screen, 500);
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+    close(fd);
+
+    printf("samples              %d (timeouts %d)\n", measured, timeouts);
+    if (measured > 0) {
+        qsort(latencies, (size_t)measured, sizeof(uint64_t), compare_u64);
+        uint64_t total = 0;
+        for (int i = 0; i < measured; i++) total += latencies[i];
+        printf("latency_ms           min %.2f  p50 %.2f  p90 %.2f  p99 %.2f  max %.2f  mean %.2f\n",
+               latencies[0] / 1e6,
+               percentile_ms(latencies, measured, 50.0),
+               percentile_ms(latencies, measured, 90.0),
+               percentile_ms(latencies, measured, 99.0),
+               latencies[measured - 1] / 1e6,
+               (double)total / measured / 1e6);
+    }
+    printf("output_bytes_per_sec sampling %.0f  held %.0f\n",
+           sample_ns > 0 ? sample_bytes * 1e9 / sample_ns : 0.0,
+           hold_ns > 0 ? hold_bytes * 1e9 / hold_ns : 0.0);
+
+    free(latencies);
+    return measured > 0 ? 0 : 1;
+}